@@ -37,27 +37,66 @@ namespace
         BLOCK_VOICE = 1,
         BLOCK_GOOGLE_API = 2,
         BLOCK_TEXT_STRING = 3,
+        BLOCK_PRESYNTHESIS = 4,
         
         // Service Key
-        SERVICE_METHOD_WAIT_MS = 4,
+        SERVICE_METHOD_WAIT_MS = 5,
+        SERVICE_STREAM_RING_CAPACITY = 6,
+        SERVICE_METRICS_INTERVAL_S = 7,
         
         // Voice Key
-        VOICE_SOCKET_PATH = 5,
-        VOICE_RECORDING_KHZ = 6,
-        VOICE_PLAYBACK_KHZ = 7,
+        VOICE_SOCKET_PATH = 8,
+        VOICE_RECORDING_KHZ = 9,
+        VOICE_PLAYBACK_KHZ = 10,
         VOICE_RECORDING_TIMEOUT_S,
         VOICE_API_PROVIDER,
+        VOICE_RECOGNIZE_REQUESTS,
+        VOICE_SYNTHESIZE_REQUESTS,
+        VOICE_STREAM_RECOGNITION,
+        VOICE_ACTIVITY_DETECTION,
+        VOICE_ACTIVITY_THRESHOLD,
+        VOICE_ACTIVITY_ONSET_MS,
+        VOICE_ACTIVITY_HANGOVER_MS,
+        VOICE_ACTIVITY_PRE_ROLL_MS,
+        VOICE_AUDIO_MEMORY_KB,
+        VOICE_RECOGNITION_KHZ,
+        VOICE_SYNTHESIS_KHZ,
+        VOICE_SILENCE_TRIM,
+        VOICE_SILENCE_THRESHOLD,
+        VOICE_SILENCE_PADDING_MS,
+        VOICE_SILENCE_MAX_PAUSE_MS,
+        VOICE_UPLOAD_ENCODING,
+        VOICE_UPLOAD_BITRATE,
+        VOICE_SYNTHESIS_CACHE_KB,
+        VOICE_PHRASE_STORE_PATH,
+        VOICE_PHRASE_STORE_MB,
+        VOICE_PRESYNTHESIS_REQUESTS,
+        VOICE_SEGMENT_SYNTHESIS,
+        VOICE_SEGMENT_MIN_LENGTH,
+        VOICE_SEGMENT_MAX_LENGTH,
+        VOICE_SYNTHESIZE_AHEAD,
+        VOICE_PLAYBACK_LEAD_MS,
+        VOICE_BARGE_IN,
+        VOICE_ECHO_CANCELLATION,
+        VOICE_ECHO_FILTER_MS,
+        VOICE_ECHO_DELAY_MS,
         
         // Google API Key
         GOOGLE_API_LANGUAGE_CODE,
         GOOGLE_API_VOICE_GENDER,
+        GOOGLE_API_REQUEST_DEADLINE_MS,
+        GOOGLE_API_KEEPALIVE_MS,
+        GOOGLE_API_CREDENTIAL_REFRESH_S,
         
         // Text String Key
         TEXT_STRING_SOCKET_PATH,
         TEXT_STRING_RECIEVE_TIMEOUT_S,
         
+        // Presynthesis Key
+        PRESYNTHESIS_PHRASES,
+        
         // Bounds
-        IDENTIFIER_MAX = TEXT_STRING_RECIEVE_TIMEOUT_S,
+        IDENTIFIER_MAX = PRESYNTHESIS_PHRASES,
 
         IDENTIFIER_COUNT = IDENTIFIER_MAX + 1
     };
@@ -69,9 +108,12 @@ namespace
         "Voice",
         "Google Cloud API",
         "TextString",
+        "Presynthesis",
         
         // Service Key
         "MethodWaitMS",
+        "StreamRingCapacity",
+        "MetricsIntervalS",
         
         // Voice Key
         "SocketPath",
@@ -79,15 +121,74 @@ namespace
         "PlaybackKHz",
         "RecordingTimeoutS",
         "APIProvider",
+        "RecognizeRequests",
+        "SynthesizeRequests",
+        "StreamRecognition",
+        "ActivityDetection",
+        "ActivityThreshold",
+        "ActivityOnsetMS",
+        "ActivityHangoverMS",
+        "ActivityPreRollMS",
+        "AudioMemoryKB",
+        "RecognitionKHz",
+        "SynthesisKHz",
+        "SilenceTrim",
+        "SilenceThreshold",
+        "SilencePaddingMS",
+        "SilenceMaxPauseMS",
+        "UploadEncoding",
+        "UploadBitrate",
+        "SynthesisCacheKB",
+        "PhraseStorePath",
+        "PhraseStoreMB",
+        "PresynthesisRequests",
+        "SegmentSynthesis",
+        "SegmentMinLength",
+        "SegmentMaxLength",
+        "SynthesizeAhead",
+        "PlaybackLeadMS",
+        "BargeIn",
+        "EchoCancellation",
+        "EchoFilterMS",
+        "EchoDelayMS",
         
         // Google API Key
         "LanguageCode",
         "VoiceGender",
+        "RequestDeadlineMS",
+        "KeepaliveMS",
+        "CredentialRefreshS",
         
         // Server Key
         "SocketPath",
-        "RecieveTimeoutS"
+        "RecieveTimeoutS",
+        
+        // Presynthesis Key
+        "Phrases"
     };
+    
+    /**
+     *  Get a optional block value.
+     *
+     *  \param c_Block The block to read from.
+     *  \param e_Key The key of the value.
+     *  \param s_Default The value returned if the key is missing.
+     *
+     *  \return The block value.
+     */
+    
+    template<typename Block>
+    std::string GetOptionalValue(Block& c_Block, Identifier e_Key, std::string const& s_Default) noexcept
+    {
+        try
+        {
+            return c_Block.GetValue(p_Identifier[e_Key]);
+        }
+        catch (...)
+        {
+            return s_Default;
+        }
+    }
 }
 
 
@@ -96,13 +197,48 @@ namespace
 //*************************************************************************************
 
 Configuration::Configuration() : u32_ServiceMethodWaitMS(100),
+                                 u32_ServiceStreamRingCapacity(128),
+                                 u32_ServiceMetricsIntervalS(300),
                                  s_VoiceSocketPath("/tmp/mrh/mrhpsspeech_voice.sock"),
                                  u32_VoiceRecordingKHz(16000),
                                  u32_VoicePlaybackKHz(16000),
                                  u32_VoiceRecordingTimeoutS(3),
                                  u8_VoiceAPIProvider(0),
+                                 u32_VoiceRecognizeRequests(4),
+                                 u32_VoiceSynthesizeRequests(4),
+                                 b_VoiceStreamRecognition(false),
+                                 b_VoiceActivityDetection(false),
+                                 u32_VoiceActivityThreshold(500),
+                                 u32_VoiceActivityOnsetMS(60),
+                                 u32_VoiceActivityHangoverMS(400),
+                                 u32_VoiceActivityPreRollMS(300),
+                                 u32_VoiceAudioMemoryKB(65536),
+                                 u32_VoiceRecognitionKHz(16000),
+                                 u32_VoiceSynthesisKHz(24000),
+                                 b_VoiceSilenceTrim(true),
+                                 u32_VoiceSilenceThreshold(256),
+                                 u32_VoiceSilencePaddingMS(100),
+                                 u32_VoiceSilenceMaxPauseMS(600),
+                                 u32_VoiceUploadEncoding(0),
+                                 u32_VoiceUploadBitrate(24000),
+                                 u32_VoiceSynthesisCacheKB(4096),
+                                 s_VoicePhraseStorePath(""),
+                                 u32_VoicePhraseStoreMB(64),
+                                 u32_VoicePresynthesisRequests(1),
+                                 b_VoiceSegmentSynthesis(true),
+                                 u32_VoiceSegmentMinLength(16),
+                                 u32_VoiceSegmentMaxLength(200),
+                                 u32_VoiceSynthesizeAhead(2),
+                                 u32_VoicePlaybackLeadMS(500),
+                                 b_VoiceBargeIn(false),
+                                 b_VoiceEchoCancellation(false),
+                                 u32_VoiceEchoFilterMS(64),
+                                 u32_VoiceEchoDelayMS(0),
                                  s_GoogleLangCode("en"),
                                  u32_GoogleVoiceGender(0),
+                                 u32_GoogleRequestDeadlineMS(10000),
+                                 u32_GoogleKeepaliveMS(300000),
+                                 u32_GoogleCredentialRefreshS(1800),
                                  s_TextStringSocketPath("/tmp/mrh/mrhpsspeech_text.sock"),
                                  u32_TextStringRecieveTimeoutS(30)
 {
@@ -115,6 +251,8 @@ Configuration::Configuration() : u32_ServiceMethodWaitMS(100),
             if (Block.GetName().compare(p_Identifier[BLOCK_SERVICE]) == 0)
             {
                 u32_ServiceMethodWaitMS = static_cast<MRH_Uint32>(std::stoull(Block.GetValue(p_Identifier[SERVICE_METHOD_WAIT_MS])));
+                u32_ServiceStreamRingCapacity = static_cast<MRH_Uint32>(std::stoull(GetOptionalValue(Block, SERVICE_STREAM_RING_CAPACITY, "128")));
+                u32_ServiceMetricsIntervalS = static_cast<MRH_Uint32>(std::stoull(GetOptionalValue(Block, SERVICE_METRICS_INTERVAL_S, "300")));
             }
             else if (Block.GetName().compare(p_Identifier[BLOCK_VOICE]) == 0)
             {
@@ -123,17 +261,77 @@ Configuration::Configuration() : u32_ServiceMethodWaitMS(100),
                 u32_VoicePlaybackKHz = static_cast<MRH_Uint32>(std::stoull(Block.GetValue(p_Identifier[VOICE_PLAYBACK_KHZ])));
                 u32_VoiceRecordingTimeoutS = static_cast<MRH_Uint32>(std::stoull(Block.GetValue(p_Identifier[VOICE_RECORDING_TIMEOUT_S])));
                 u8_VoiceAPIProvider = static_cast<MRH_Uint8>(std::stoull(Block.GetValue(p_Identifier[VOICE_API_PROVIDER])));
+                u32_VoiceRecognizeRequests = static_cast<MRH_Uint32>(std::stoull(GetOptionalValue(Block, VOICE_RECOGNIZE_REQUESTS, "4")));
+                u32_VoiceSynthesizeRequests = static_cast<MRH_Uint32>(std::stoull(GetOptionalValue(Block, VOICE_SYNTHESIZE_REQUESTS, "4")));
+                b_VoiceStreamRecognition = static_cast<bool>(std::stoull(GetOptionalValue(Block, VOICE_STREAM_RECOGNITION, "0")));
+                b_VoiceActivityDetection = static_cast<bool>(std::stoull(GetOptionalValue(Block, VOICE_ACTIVITY_DETECTION, "0")));
+                u32_VoiceActivityThreshold = static_cast<MRH_Uint32>(std::stoull(GetOptionalValue(Block, VOICE_ACTIVITY_THRESHOLD, "500")));
+                u32_VoiceActivityOnsetMS = static_cast<MRH_Uint32>(std::stoull(GetOptionalValue(Block, VOICE_ACTIVITY_ONSET_MS, "60")));
+                u32_VoiceActivityHangoverMS = static_cast<MRH_Uint32>(std::stoull(GetOptionalValue(Block, VOICE_ACTIVITY_HANGOVER_MS, "400")));
+                u32_VoiceActivityPreRollMS = static_cast<MRH_Uint32>(std::stoull(GetOptionalValue(Block, VOICE_ACTIVITY_PRE_ROLL_MS, "300")));
+                u32_VoiceAudioMemoryKB = static_cast<MRH_Uint32>(std::stoull(GetOptionalValue(Block, VOICE_AUDIO_MEMORY_KB, "65536")));
+                u32_VoiceRecognitionKHz = static_cast<MRH_Uint32>(std::stoull(GetOptionalValue(Block, VOICE_RECOGNITION_KHZ, "16000")));
+                u32_VoiceSynthesisKHz = static_cast<MRH_Uint32>(std::stoull(GetOptionalValue(Block, VOICE_SYNTHESIS_KHZ, "24000")));
+                b_VoiceSilenceTrim = static_cast<bool>(std::stoull(GetOptionalValue(Block, VOICE_SILENCE_TRIM, "1")));
+                u32_VoiceSilenceThreshold = static_cast<MRH_Uint32>(std::stoull(GetOptionalValue(Block, VOICE_SILENCE_THRESHOLD, "256")));
+                u32_VoiceSilencePaddingMS = static_cast<MRH_Uint32>(std::stoull(GetOptionalValue(Block, VOICE_SILENCE_PADDING_MS, "100")));
+                u32_VoiceSilenceMaxPauseMS = static_cast<MRH_Uint32>(std::stoull(GetOptionalValue(Block, VOICE_SILENCE_MAX_PAUSE_MS, "600")));
+                u32_VoiceUploadEncoding = static_cast<MRH_Uint32>(std::stoull(GetOptionalValue(Block, VOICE_UPLOAD_ENCODING, "0")));
+                u32_VoiceUploadBitrate = static_cast<MRH_Uint32>(std::stoull(GetOptionalValue(Block, VOICE_UPLOAD_BITRATE, "24000")));
+                u32_VoiceSynthesisCacheKB = static_cast<MRH_Uint32>(std::stoull(GetOptionalValue(Block, VOICE_SYNTHESIS_CACHE_KB, "4096")));
+                s_VoicePhraseStorePath = GetOptionalValue(Block, VOICE_PHRASE_STORE_PATH, "");
+                u32_VoicePhraseStoreMB = static_cast<MRH_Uint32>(std::stoull(GetOptionalValue(Block, VOICE_PHRASE_STORE_MB, "64")));
+                u32_VoicePresynthesisRequests = static_cast<MRH_Uint32>(std::stoull(GetOptionalValue(Block, VOICE_PRESYNTHESIS_REQUESTS, "1")));
+                b_VoiceSegmentSynthesis = static_cast<bool>(std::stoull(GetOptionalValue(Block, VOICE_SEGMENT_SYNTHESIS, "1")));
+                u32_VoiceSegmentMinLength = static_cast<MRH_Uint32>(std::stoull(GetOptionalValue(Block, VOICE_SEGMENT_MIN_LENGTH, "16")));
+                u32_VoiceSegmentMaxLength = static_cast<MRH_Uint32>(std::stoull(GetOptionalValue(Block, VOICE_SEGMENT_MAX_LENGTH, "200")));
+                u32_VoiceSynthesizeAhead = static_cast<MRH_Uint32>(std::stoull(GetOptionalValue(Block, VOICE_SYNTHESIZE_AHEAD, "2")));
+                u32_VoicePlaybackLeadMS = static_cast<MRH_Uint32>(std::stoull(GetOptionalValue(Block, VOICE_PLAYBACK_LEAD_MS, "500")));
+                b_VoiceBargeIn = static_cast<bool>(std::stoull(GetOptionalValue(Block, VOICE_BARGE_IN, "0")));
+                b_VoiceEchoCancellation = static_cast<bool>(std::stoull(GetOptionalValue(Block, VOICE_ECHO_CANCELLATION, "0")));
+                u32_VoiceEchoFilterMS = static_cast<MRH_Uint32>(std::stoull(GetOptionalValue(Block, VOICE_ECHO_FILTER_MS, "64")));
+                u32_VoiceEchoDelayMS = static_cast<MRH_Uint32>(std::stoull(GetOptionalValue(Block, VOICE_ECHO_DELAY_MS, "0")));
             }
             else if (Block.GetName().compare(p_Identifier[BLOCK_GOOGLE_API]) == 0)
             {
                 s_GoogleLangCode = Block.GetValue(p_Identifier[GOOGLE_API_LANGUAGE_CODE]);
                 u32_GoogleVoiceGender = static_cast<MRH_Uint32>(std::stoull(Block.GetValue(p_Identifier[GOOGLE_API_VOICE_GENDER])));
+                u32_GoogleRequestDeadlineMS = static_cast<MRH_Uint32>(std::stoull(GetOptionalValue(Block, GOOGLE_API_REQUEST_DEADLINE_MS, "10000")));
+                u32_GoogleKeepaliveMS = static_cast<MRH_Uint32>(std::stoull(GetOptionalValue(Block, GOOGLE_API_KEEPALIVE_MS, "300000")));
+                u32_GoogleCredentialRefreshS = static_cast<MRH_Uint32>(std::stoull(GetOptionalValue(Block, GOOGLE_API_CREDENTIAL_REFRESH_S, "1800")));
             }
             else if (Block.GetName().compare(p_Identifier[BLOCK_TEXT_STRING]) == 0)
             {
                 s_TextStringSocketPath = Block.GetValue(p_Identifier[TEXT_STRING_SOCKET_PATH]);
                 u32_TextStringRecieveTimeoutS = static_cast<MRH_Uint32>(std::stoull(Block.GetValue(p_Identifier[TEXT_STRING_RECIEVE_TIMEOUT_S])));
             }
+            else if (Block.GetName().compare(p_Identifier[BLOCK_PRESYNTHESIS]) == 0)
+            {
+                // @NOTE: Phrases use the api provider voice, output is 
+                //        only synthesised with that voice
+                std::string s_Phrases = Block.GetValue(p_Identifier[PRESYNTHESIS_PHRASES]);
+                size_t us_Start = 0;
+                size_t us_End;
+                
+                // Phrases are separated by '|'
+                do
+                {
+                    us_End = s_Phrases.find('|', us_Start);
+                    
+                    if (us_End == std::string::npos)
+                    {
+                        us_End = s_Phrases.size();
+                    }
+                    
+                    if (us_End > us_Start)
+                    {
+                        v_VoicePresynthesis.emplace_back(s_Phrases.substr(us_Start, us_End - us_Start));
+                    }
+                    
+                    us_Start = us_End + 1;
+                }
+                while (us_Start < s_Phrases.size());
+            }
         }
     }
     catch (std::exception& e)
@@ -154,6 +352,16 @@ MRH_Uint32 Configuration::GetServiceMethodWaitMS() const noexcept
     return u32_ServiceMethodWaitMS;
 }
 
+MRH_Uint32 Configuration::GetServiceStreamRingCapacity() const noexcept
+{
+    return u32_ServiceStreamRingCapacity;
+}
+
+MRH_Uint32 Configuration::GetServiceMetricsIntervalS() const noexcept
+{
+    return u32_ServiceMetricsIntervalS;
+}
+
 std::string Configuration::GetVoiceSocketPath() const noexcept
 {
     return s_VoiceSocketPath;
@@ -179,6 +387,161 @@ MRH_Uint8 Configuration::GetVoiceAPIProvider() const noexcept
     return u8_VoiceAPIProvider;
 }
 
+MRH_Uint32 Configuration::GetVoiceRecognizeRequests() const noexcept
+{
+    return u32_VoiceRecognizeRequests;
+}
+
+MRH_Uint32 Configuration::GetVoiceSynthesizeRequests() const noexcept
+{
+    return u32_VoiceSynthesizeRequests;
+}
+
+bool Configuration::GetVoiceStreamRecognition() const noexcept
+{
+    return b_VoiceStreamRecognition;
+}
+
+bool Configuration::GetVoiceActivityDetection() const noexcept
+{
+    return b_VoiceActivityDetection;
+}
+
+MRH_Uint32 Configuration::GetVoiceActivityThreshold() const noexcept
+{
+    return u32_VoiceActivityThreshold;
+}
+
+MRH_Uint32 Configuration::GetVoiceActivityOnsetMS() const noexcept
+{
+    return u32_VoiceActivityOnsetMS;
+}
+
+MRH_Uint32 Configuration::GetVoiceActivityHangoverMS() const noexcept
+{
+    return u32_VoiceActivityHangoverMS;
+}
+
+MRH_Uint32 Configuration::GetVoiceActivityPreRollMS() const noexcept
+{
+    return u32_VoiceActivityPreRollMS;
+}
+
+MRH_Uint32 Configuration::GetVoiceAudioMemoryKB() const noexcept
+{
+    return u32_VoiceAudioMemoryKB;
+}
+
+MRH_Uint32 Configuration::GetVoiceRecognitionKHz() const noexcept
+{
+    return u32_VoiceRecognitionKHz;
+}
+
+MRH_Uint32 Configuration::GetVoiceSynthesisKHz() const noexcept
+{
+    return u32_VoiceSynthesisKHz;
+}
+
+bool Configuration::GetVoiceSilenceTrim() const noexcept
+{
+    return b_VoiceSilenceTrim;
+}
+
+MRH_Uint32 Configuration::GetVoiceSilenceThreshold() const noexcept
+{
+    return u32_VoiceSilenceThreshold;
+}
+
+MRH_Uint32 Configuration::GetVoiceSilencePaddingMS() const noexcept
+{
+    return u32_VoiceSilencePaddingMS;
+}
+
+MRH_Uint32 Configuration::GetVoiceSilenceMaxPauseMS() const noexcept
+{
+    return u32_VoiceSilenceMaxPauseMS;
+}
+
+MRH_Uint32 Configuration::GetVoiceUploadEncoding() const noexcept
+{
+    return u32_VoiceUploadEncoding;
+}
+
+MRH_Uint32 Configuration::GetVoiceUploadBitrate() const noexcept
+{
+    return u32_VoiceUploadBitrate;
+}
+
+MRH_Uint32 Configuration::GetVoiceSynthesisCacheKB() const noexcept
+{
+    return u32_VoiceSynthesisCacheKB;
+}
+
+std::string Configuration::GetVoicePhraseStorePath() const noexcept
+{
+    return s_VoicePhraseStorePath;
+}
+
+MRH_Uint32 Configuration::GetVoicePhraseStoreMB() const noexcept
+{
+    return u32_VoicePhraseStoreMB;
+}
+
+MRH_Uint32 Configuration::GetVoicePresynthesisRequests() const noexcept
+{
+    return u32_VoicePresynthesisRequests;
+}
+
+bool Configuration::GetVoiceSegmentSynthesis() const noexcept
+{
+    return b_VoiceSegmentSynthesis;
+}
+
+MRH_Uint32 Configuration::GetVoiceSegmentMinLength() const noexcept
+{
+    return u32_VoiceSegmentMinLength;
+}
+
+MRH_Uint32 Configuration::GetVoiceSegmentMaxLength() const noexcept
+{
+    return u32_VoiceSegmentMaxLength;
+}
+
+MRH_Uint32 Configuration::GetVoiceSynthesizeAhead() const noexcept
+{
+    return u32_VoiceSynthesizeAhead;
+}
+
+MRH_Uint32 Configuration::GetVoicePlaybackLeadMS() const noexcept
+{
+    return u32_VoicePlaybackLeadMS;
+}
+
+bool Configuration::GetVoiceBargeIn() const noexcept
+{
+    return b_VoiceBargeIn;
+}
+
+bool Configuration::GetVoiceEchoCancellation() const noexcept
+{
+    return b_VoiceEchoCancellation;
+}
+
+MRH_Uint32 Configuration::GetVoiceEchoFilterMS() const noexcept
+{
+    return u32_VoiceEchoFilterMS;
+}
+
+MRH_Uint32 Configuration::GetVoiceEchoDelayMS() const noexcept
+{
+    return u32_VoiceEchoDelayMS;
+}
+
+std::vector<std::string> const& Configuration::GetVoicePresynthesis() const noexcept
+{
+    return v_VoicePresynthesis;
+}
+
 std::string Configuration::GetGoogleLanguageCode() const noexcept
 {
     return s_GoogleLangCode;
@@ -189,6 +552,21 @@ MRH_Uint32 Configuration::GetGoogleVoiceGender() const noexcept
     return u32_GoogleVoiceGender;
 }
 
+MRH_Uint32 Configuration::GetGoogleRequestDeadlineMS() const noexcept
+{
+    return u32_GoogleRequestDeadlineMS;
+}
+
+MRH_Uint32 Configuration::GetGoogleKeepaliveMS() const noexcept
+{
+    return u32_GoogleKeepaliveMS;
+}
+
+MRH_Uint32 Configuration::GetGoogleCredentialRefreshS() const noexcept
+{
+    return u32_GoogleCredentialRefreshS;
+}
+
 std::string Configuration::GetTextStringSocketPath() const noexcept
 {
     return s_TextStringSocketPath;
@@ -18,6 +18,8 @@
 #define Configuration_h
 
 // C / C++
+#include <string>
+#include <vector>
 
 // External
 #include <MRH_Typedefs.h>
@@ -58,6 +60,22 @@ public:
     
     MRH_Uint32 GetServiceMethodWaitMS() const noexcept;
     
+    /**
+     *  Get the amount of messages buffered per local stream direction.
+     *
+     *  \return The local stream ring capacity.
+     */
+    
+    MRH_Uint32 GetServiceStreamRingCapacity() const noexcept;
+    
+    /**
+     *  Get the interval in which service metrics are logged in seconds.
+     *
+     *  \return The metrics interval in seconds, 0 if disabled.
+     */
+    
+    MRH_Uint32 GetServiceMetricsIntervalS() const noexcept;
+    
     /**
      *  Get the full voice socket file path.
      *
@@ -98,6 +116,254 @@ public:
     
     MRH_Uint8 GetVoiceAPIProvider() const noexcept;
     
+    /**
+     *  Get the maximum amount of active voice recognition requests.
+     *
+     *  \return The voice recognition request limit.
+     */
+    
+    MRH_Uint32 GetVoiceRecognizeRequests() const noexcept;
+    
+    /**
+     *  Get the maximum amount of active voice synthesis requests.
+     *
+     *  \return The voice synthesis request limit.
+     */
+    
+    MRH_Uint32 GetVoiceSynthesizeRequests() const noexcept;
+    
+    /**
+     *  Get if recorded audio is streamed to the recognizer.
+     *
+     *  \return true if streamed, false if not.
+     */
+    
+    bool GetVoiceStreamRecognition() const noexcept;
+    
+    /**
+     *  Get if voice activity detection ends recorded utterances.
+     *
+     *  \return true if used, false if not.
+     */
+    
+    bool GetVoiceActivityDetection() const noexcept;
+    
+    /**
+     *  Get the minimum average amplitude of detected speech.
+     *
+     *  \return The speech amplitude threshold.
+     */
+    
+    MRH_Uint32 GetVoiceActivityThreshold() const noexcept;
+    
+    /**
+     *  Get the speech required in milliseconds to start a utterance.
+     *
+     *  \return The utterance onset in milliseconds.
+     */
+    
+    MRH_Uint32 GetVoiceActivityOnsetMS() const noexcept;
+    
+    /**
+     *  Get the silence required in milliseconds to end a utterance.
+     *
+     *  \return The utterance hangover in milliseconds.
+     */
+    
+    MRH_Uint32 GetVoiceActivityHangoverMS() const noexcept;
+    
+    /**
+     *  Get the audio in milliseconds before the onset added to a utterance.
+     *
+     *  \return The utterance pre-roll in milliseconds.
+     */
+    
+    MRH_Uint32 GetVoiceActivityPreRollMS() const noexcept;
+    
+    /**
+     *  Get the maximum memory in kilobytes used for audio.
+     *
+     *  \return The audio memory limit in kilobytes.
+     */
+    
+    MRH_Uint32 GetVoiceAudioMemoryKB() const noexcept;
+    
+    /**
+     *  Get the KHz of audio sent to the API provider for transcription.
+     *
+     *  \return The recognition KHz.
+     */
+    
+    MRH_Uint32 GetVoiceRecognitionKHz() const noexcept;
+    
+    /**
+     *  Get the KHz of audio requested from the API provider for synthesis.
+     *
+     *  \return The synthesis KHz.
+     */
+    
+    MRH_Uint32 GetVoiceSynthesisKHz() const noexcept;
+    
+    /**
+     *  Check if silence is trimmed from recorded and synthesised audio.
+     *
+     *  \return true if trimmed, false if not.
+     */
+    
+    bool GetVoiceSilenceTrim() const noexcept;
+    
+    /**
+     *  Get the peak amplitude below which audio is silent.
+     *
+     *  \return The silence threshold.
+     */
+    
+    MRH_Uint32 GetVoiceSilenceThreshold() const noexcept;
+    
+    /**
+     *  Get the silence kept before and after trimmed audio.
+     *
+     *  \return The silence padding in milliseconds.
+     */
+    
+    MRH_Uint32 GetVoiceSilencePaddingMS() const noexcept;
+    
+    /**
+     *  Get the longest pause kept inside trimmed audio.
+     *
+     *  \return The maximum pause in milliseconds.
+     */
+    
+    MRH_Uint32 GetVoiceSilenceMaxPauseMS() const noexcept;
+    
+    /**
+     *  Get the encoding of audio sent for transcription.
+     *
+     *  \return The upload encoding.
+     */
+    
+    MRH_Uint32 GetVoiceUploadEncoding() const noexcept;
+    
+    /**
+     *  Get the bitrate of opus encoded audio sent for transcription.
+     *
+     *  \return The upload bitrate in bits per second.
+     */
+    
+    MRH_Uint32 GetVoiceUploadBitrate() const noexcept;
+    
+    /**
+     *  Get the memory used to cache synthesised audio.
+     *
+     *  \return The synthesis cache size in kilobytes.
+     */
+    
+    MRH_Uint32 GetVoiceSynthesisCacheKB() const noexcept;
+    
+    /**
+     *  Get the directory of the persistent phrase store.
+     *
+     *  \return The phrase store directory path, empty if disabled.
+     */
+    
+    std::string GetVoicePhraseStorePath() const noexcept;
+    
+    /**
+     *  Get the maximum size of the persistent phrase store.
+     *
+     *  \return The phrase store size in megabytes.
+     */
+    
+    MRH_Uint32 GetVoicePhraseStoreMB() const noexcept;
+    
+    /**
+     *  Get the maximum amount of pre-synthesis requests active at the same time.
+     *
+     *  \return The pre-synthesis request count.
+     */
+    
+    MRH_Uint32 GetVoicePresynthesisRequests() const noexcept;
+    
+    /**
+     *  Check if output strings are split into segments synthesized in parallel.
+     *
+     *  \return true if split, false if not.
+     */
+    
+    bool GetVoiceSegmentSynthesis() const noexcept;
+    
+    /**
+     *  Get the minimum length in bytes of a sentence segment.
+     *
+     *  \return The minimum segment length.
+     */
+    
+    MRH_Uint32 GetVoiceSegmentMinLength() const noexcept;
+    
+    /**
+     *  Get the maximum length in bytes of a segment before splitting at clauses.
+     *
+     *  \return The maximum segment length.
+     */
+    
+    MRH_Uint32 GetVoiceSegmentMaxLength() const noexcept;
+    
+    /**
+     *  Get the amount of output strings synthesized ahead of playback.
+     *
+     *  \return The synthesis depth.
+     */
+    
+    MRH_Uint32 GetVoiceSynthesizeAhead() const noexcept;
+    
+    /**
+     *  Get the audio in milliseconds sent ahead of playback.
+     *
+     *  \return The playback lead in milliseconds.
+     */
+    
+    MRH_Uint32 GetVoicePlaybackLeadMS() const noexcept;
+    
+    /**
+     *  Check if detected speech interrupts playback.
+     *
+     *  \return true if interrupted, false if not.
+     */
+    
+    bool GetVoiceBargeIn() const noexcept;
+    
+    /**
+     *  Check if playback echo is removed from recorded audio.
+     *
+     *  \return true if removed, false if not.
+     */
+    
+    bool GetVoiceEchoCancellation() const noexcept;
+    
+    /**
+     *  Get the echo length in milliseconds covered by the echo filter.
+     *
+     *  \return The echo filter length in milliseconds.
+     */
+    
+    MRH_Uint32 GetVoiceEchoFilterMS() const noexcept;
+    
+    /**
+     *  Get the delay in milliseconds between sent and recorded playback.
+     *
+     *  \return The echo delay in milliseconds.
+     */
+    
+    MRH_Uint32 GetVoiceEchoDelayMS() const noexcept;
+    
+    /**
+     *  Get the phrases synthesised on startup.
+     *
+     *  \return The pre-synthesis phrases.
+     */
+    
+    std::vector<std::string> const& GetVoicePresynthesis() const noexcept;
+    
     /**
      *  Get the voice google cloud api language code.
      *
@@ -114,6 +380,30 @@ public:
     
     MRH_Uint32 GetGoogleVoiceGender() const noexcept;
     
+    /**
+     *  Get the voice google cloud api request deadline in milliseconds.
+     *
+     *  \return The google cloud api request deadline in milliseconds.
+     */
+    
+    MRH_Uint32 GetGoogleRequestDeadlineMS() const noexcept;
+    
+    /**
+     *  Get the voice google cloud api connection keepalive interval in milliseconds.
+     *
+     *  \return The google cloud api keepalive interval in milliseconds.
+     */
+    
+    MRH_Uint32 GetGoogleKeepaliveMS() const noexcept;
+    
+    /**
+     *  Get the voice google cloud api credential refresh interval in seconds.
+     *
+     *  \return The google cloud api credential refresh interval in seconds.
+     */
+    
+    MRH_Uint32 GetGoogleCredentialRefreshS() const noexcept;
+    
     /**
      *  Get the full text string socket file path.
      *
@@ -138,6 +428,8 @@ private:
 
     // Service
     MRH_Uint32 u32_ServiceMethodWaitMS;
+    MRH_Uint32 u32_ServiceStreamRingCapacity;
+    MRH_Uint32 u32_ServiceMetricsIntervalS;
     
     // Voice
     std::string s_VoiceSocketPath;
@@ -145,10 +437,44 @@ private:
     MRH_Uint32 u32_VoicePlaybackKHz;
     MRH_Uint32 u32_VoiceRecordingTimeoutS;
     MRH_Uint8 u8_VoiceAPIProvider;
+    MRH_Uint32 u32_VoiceRecognizeRequests;
+    MRH_Uint32 u32_VoiceSynthesizeRequests;
+    bool b_VoiceStreamRecognition;
+    bool b_VoiceActivityDetection;
+    MRH_Uint32 u32_VoiceActivityThreshold;
+    MRH_Uint32 u32_VoiceActivityOnsetMS;
+    MRH_Uint32 u32_VoiceActivityHangoverMS;
+    MRH_Uint32 u32_VoiceActivityPreRollMS;
+    MRH_Uint32 u32_VoiceAudioMemoryKB;
+    MRH_Uint32 u32_VoiceRecognitionKHz;
+    MRH_Uint32 u32_VoiceSynthesisKHz;
+    bool b_VoiceSilenceTrim;
+    MRH_Uint32 u32_VoiceSilenceThreshold;
+    MRH_Uint32 u32_VoiceSilencePaddingMS;
+    MRH_Uint32 u32_VoiceSilenceMaxPauseMS;
+    MRH_Uint32 u32_VoiceUploadEncoding;
+    MRH_Uint32 u32_VoiceUploadBitrate;
+    MRH_Uint32 u32_VoiceSynthesisCacheKB;
+    std::string s_VoicePhraseStorePath;
+    MRH_Uint32 u32_VoicePhraseStoreMB;
+    MRH_Uint32 u32_VoicePresynthesisRequests;
+    bool b_VoiceSegmentSynthesis;
+    MRH_Uint32 u32_VoiceSegmentMinLength;
+    MRH_Uint32 u32_VoiceSegmentMaxLength;
+    MRH_Uint32 u32_VoiceSynthesizeAhead;
+    MRH_Uint32 u32_VoicePlaybackLeadMS;
+    bool b_VoiceBargeIn;
+    bool b_VoiceEchoCancellation;
+    MRH_Uint32 u32_VoiceEchoFilterMS;
+    MRH_Uint32 u32_VoiceEchoDelayMS;
+    std::vector<std::string> v_VoicePresynthesis;
     
     // Google API
     std::string s_GoogleLangCode;
     MRH_Uint32 u32_GoogleVoiceGender;
+    MRH_Uint32 u32_GoogleRequestDeadlineMS;
+    MRH_Uint32 u32_GoogleKeepaliveMS;
+    MRH_Uint32 u32_GoogleCredentialRefreshS;
     
     // Server
     std::string s_TextStringSocketPath;
@@ -0,0 +1,152 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <string>
+
+// External
+#include <libmrhpsb/MRH_PSBLogger.h>
+
+// Project
+#include "./Metrics.h"
+
+namespace
+{
+    const char* p_CounterName[Metrics::COUNTER_COUNT] =
+    {
+        // Message Pool
+        "MessagePoolHit",
+        "MessagePoolMiss",
+        "MessagePoolHighWater",
+        
+        // API Provider
+        "ProviderRequest",
+        "ProviderFailure",
+        "ProviderCancelled",
+        "ProviderReconnect",
+        
+        // Voice Activity
+        "VoiceEndpoint",
+        "VoiceEndpointLatencyMS",
+        "VoiceEndpointLatencyMaxMS",
+        
+        // Audio Pool
+        "AudioPoolHighWater",
+        "AudioPoolExhausted",
+        
+        // Audio Encoder
+        "AudioEncode",
+        "AudioEncodeTimeUS",
+        "AudioEncodeInputBytes",
+        "AudioEncodeOutputBytes",
+        
+        // Synthesis Cache
+        "SynthesisCacheHit",
+        "SynthesisCacheMiss",
+        "SynthesisCacheSavedMS",
+        "SynthesisCacheEvicted",
+        
+        // Phrase Store
+        "PhraseStoreHit",
+        "PhraseStoreMiss",
+        "PhraseStoreEvicted",
+        "PhraseStoreCompaction",
+        
+        // Barge-In
+        "VoiceBargeIn",
+        "VoiceBargeInCancelled",
+        
+        // Echo Cancellation
+        "EchoCancelFrame",
+        "EchoCancelTimeUS",
+        "EchoCancelTimeMaxUS"
+    };
+}
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+Metrics::Metrics() noexcept
+{
+    for (size_t i = 0; i < COUNTER_COUNT; ++i)
+    {
+        p_Counter[i] = 0;
+    }
+}
+
+Metrics::~Metrics() noexcept
+{}
+
+//*************************************************************************************
+// Singleton
+//*************************************************************************************
+
+Metrics& Metrics::Singleton() noexcept
+{
+    static Metrics c_Metrics;
+    return c_Metrics;
+}
+
+//*************************************************************************************
+// Update
+//*************************************************************************************
+
+void Metrics::Add(Counter e_Counter, MRH_Uint64 u64_Value) noexcept
+{
+    p_Counter[e_Counter].fetch_add(u64_Value, std::memory_order_relaxed);
+}
+
+void Metrics::SetMax(Counter e_Counter, MRH_Uint64 u64_Value) noexcept
+{
+    MRH_Uint64 u64_Current = p_Counter[e_Counter].load(std::memory_order_relaxed);
+    
+    while (u64_Current < u64_Value && 
+           p_Counter[e_Counter].compare_exchange_weak(u64_Current, u64_Value, std::memory_order_relaxed) == false)
+    {}
+}
+
+//*************************************************************************************
+// Log
+//*************************************************************************************
+
+void Metrics::Log() noexcept
+{
+    try
+    {
+        std::string s_Metrics = "Metrics: [";
+        
+        for (size_t i = 0; i < COUNTER_COUNT; ++i)
+        {
+            s_Metrics += " " + std::string(p_CounterName[i]) + "=" + std::to_string(Get(static_cast<Counter>(i)));
+        }
+        
+        MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::INFO, s_Metrics + " ]",
+                                       "Metrics.cpp", __LINE__);
+    }
+    catch (...)
+    {}
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+MRH_Uint64 Metrics::Get(Counter e_Counter) const noexcept
+{
+    return p_Counter[e_Counter].load(std::memory_order_relaxed);
+}
@@ -0,0 +1,178 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef Metrics_h
+#define Metrics_h
+
+// C / C++
+#include <atomic>
+
+// External
+#include <MRH_Typedefs.h>
+
+// Project
+
+
+class Metrics
+{
+public:
+    
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+    
+    enum Counter
+    {
+        // Message Pool
+        MESSAGE_POOL_HIT = 0,
+        MESSAGE_POOL_MISS = 1,
+        MESSAGE_POOL_HIGH_WATER = 2,
+        
+        // API Provider
+        PROVIDER_REQUEST = 3,
+        PROVIDER_FAILURE = 4,
+        PROVIDER_CANCELLED = 5,
+        PROVIDER_RECONNECT = 6,
+        
+        // Voice Activity
+        VOICE_ENDPOINT = 7,
+        VOICE_ENDPOINT_LATENCY_MS = 8, // Sum of all endpoints
+        VOICE_ENDPOINT_LATENCY_MAX_MS = 9,
+        
+        // Audio Pool
+        AUDIO_POOL_HIGH_WATER = 10,
+        AUDIO_POOL_EXHAUSTED = 11,
+        
+        // Audio Encoder
+        AUDIO_ENCODE = 12,
+        AUDIO_ENCODE_TIME_US = 13, // Sum of all encodes
+        AUDIO_ENCODE_INPUT_BYTES = 14,
+        AUDIO_ENCODE_OUTPUT_BYTES = 15,
+        
+        // Synthesis Cache
+        SYNTHESIS_CACHE_HIT = 16,
+        SYNTHESIS_CACHE_MISS = 17,
+        SYNTHESIS_CACHE_SAVED_MS = 18, // Sum of provider latency for all hits
+        SYNTHESIS_CACHE_EVICTED = 19,
+        
+        // Phrase Store
+        PHRASE_STORE_HIT = 20,
+        PHRASE_STORE_MISS = 21,
+        PHRASE_STORE_EVICTED = 22,
+        PHRASE_STORE_COMPACTION = 23,
+        
+        // Barge-In
+        VOICE_BARGE_IN = 24,
+        VOICE_BARGE_IN_CANCELLED = 25, // Cancelled output strings
+        
+        // Echo Cancellation
+        ECHO_CANCEL_FRAME = 26,
+        ECHO_CANCEL_TIME_US = 27, // Sum of all frames
+        ECHO_CANCEL_TIME_MAX_US = 28,
+        
+        // Bounds
+        COUNTER_MAX = ECHO_CANCEL_TIME_MAX_US,
+        
+        COUNTER_COUNT = COUNTER_MAX + 1
+    };
+    
+    //*************************************************************************************
+    // Singleton
+    //*************************************************************************************
+    
+    /**
+     *  Get the class instance. This function is thread safe.
+     *
+     *  \return The class instance.
+     */
+    
+    static Metrics& Singleton() noexcept;
+    
+    //*************************************************************************************
+    // Update
+    //*************************************************************************************
+    
+    /**
+     *  Add to a counter. This function is thread safe.
+     *
+     *  \param e_Counter The counter to add to.
+     *  \param u64_Value The value to add.
+     */
+    
+    void Add(Counter e_Counter, MRH_Uint64 u64_Value = 1) noexcept;
+    
+    /**
+     *  Raise a counter to a value if the value is larger. This function is thread safe.
+     *
+     *  \param e_Counter The counter to update.
+     *  \param u64_Value The new possible maximum.
+     */
+    
+    void SetMax(Counter e_Counter, MRH_Uint64 u64_Value) noexcept;
+    
+    //*************************************************************************************
+    // Log
+    //*************************************************************************************
+    
+    /**
+     *  Log all counters. This function is thread safe.
+     */
+    
+    void Log() noexcept;
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the current value of a counter. This function is thread safe.
+     *
+     *  \param e_Counter The counter to get.
+     *
+     *  \return The counter value.
+     */
+    
+    MRH_Uint64 Get(Counter e_Counter) const noexcept;
+    
+private:
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     */
+    
+    Metrics() noexcept;
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~Metrics() noexcept;
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    std::atomic<MRH_Uint64> p_Counter[COUNTER_COUNT];
+    
+protected:
+    
+};
+
+#endif /* Metrics_h */
@@ -15,201 +15,324 @@
  */
 
 // C / C++
+#include <cstring>
 
 // External
 #include <libmrhpsb/MRH_PSBLogger.h>
-#include <libmrhls.h>
 
 // Project
 #include "./LocalStream.h"
 
+// Pre-defined
+#define LOCAL_STREAM_CONNECT_RETRY_MS 1000
+#define LOCAL_STREAM_READ_MS 10
+
+namespace
+{
+    //*************************************************************************************
+    // Write
+    //*************************************************************************************
+    
+    /**
+     *  Write as many queued messages as the socket accepts.
+     *  
+     *  \param p_Stream The local stream to write to.
+     *  \param c_Send The messages to write. Written messages are removed.
+     *  
+     *  \return 0 if all messages were written, 1 if the socket is full and 
+     *          -1 on failure.
+     */
+    
+    int Flush(MRH_LocalStream* p_Stream, MessageRing& c_Send) noexcept
+    {
+        MessagePool::Buffer* p_Message;
+        int i_Result;
+        
+        while ((p_Message = c_Send.GetRead()) != NULL)
+        {
+            // @NOTE: libmrhls keeps a partially written message and continues 
+            //        it on the next call, the message stays until fully written
+            if ((i_Result = MRH_LS_Write(p_Stream, p_Message->GetData(), p_Message->GetSize())) != 0)
+            {
+                return i_Result < 0 ? -1 : 1;
+            }
+            
+            c_Send.Pop();
+        }
+        
+        return 0;
+    }
+}
+
 
 //*************************************************************************************
 // Constructor / Destructor
 //*************************************************************************************
 
-LocalStream::LocalStream(std::string const& s_FilePath) : b_Update(true),
-                                                          b_Connected(false)
+LocalStream::LocalStream(LocalStreamReactor& c_Reactor, std::string const& s_FilePath, size_t us_RingCapacity) : c_Reactor(c_Reactor),
+                                                                                                                 s_FilePath(s_FilePath),
+                                                                                                                 p_Stream(NULL),
+                                                                                                                 u32_VersionSize(0),
+                                                                                                                 u32_PartialWrites(0),
+                                                                                                                 b_Connected(false),
+                                                                                                                 b_ReadBlocked(false),
+                                                                                                                 c_Received(us_RingCapacity),
+                                                                                                                 c_Send(us_RingCapacity)
 {
+    MRH_PSBLogger& c_Logger = MRH_PSBLogger::Singleton();
+    
+    // Build stream first
+    c_Logger.Log(MRH_PSBLogger::INFO, "Opening local stream: " + s_FilePath,
+                 "LocalStream.cpp", __LINE__);
+    
+    if ((p_Stream = MRH_LS_Open(s_FilePath.c_str(), 0)) == NULL)
+    {
+        // @NOTE: No exception, the service stays usable with other streams
+        c_Logger.Log(MRH_PSBLogger::ERROR, MRH_ERR_GetLocalStreamErrorString(),
+                     "LocalStream.cpp", __LINE__);
+        return;
+    }
+    
+    // @NOTE: libmrhls does not expose its socket descriptors, reads and 
+    //        connects are polled, sends wake the reactor immediately
+    c_Logger.Log(MRH_PSBLogger::WARNING, "Local stream socket events unavailable, polling reads every " +
+                                         std::to_string(LOCAL_STREAM_READ_MS) +
+                                         " ms and connections every " +
+                                         std::to_string(LOCAL_STREAM_CONNECT_RETRY_MS) +
+                                         " ms.",
+                 "LocalStream.cpp", __LINE__);
+    
     try
     {
-        c_Thread = std::thread(Update, 
-                               this, 
-                               s_FilePath);
+        c_Reactor.Add(this);
     }
-    catch (std::exception& e)
+    catch (...)
     {
-        throw Exception(e.what());
+        MRH_LS_Close(p_Stream);
+        throw;
     }
 }
 
 LocalStream::~LocalStream() noexcept
 {
-    b_Update = false;
-    c_Thread.join();
+    if (p_Stream == NULL)
+    {
+        return;
+    }
+    
+    // Stop servicing first, the stream is ours afterwards
+    c_Reactor.Remove(this);
     
-    ClearReceived();
-    ClearSend();
+    MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::INFO, "Local stream terminated.",
+                                   "LocalStream.cpp", __LINE__);
+    
+    MRH_LS_Close(p_Stream);
 }
 
 //*************************************************************************************
 // Update
 //*************************************************************************************
 
-void LocalStream::Update(LocalStream* p_Instance, std::string s_FilePath) noexcept
+int LocalStream::Update() noexcept
 {
-    MRH_PSBLogger& c_Logger = MRH_PSBLogger::Singleton();
-    std::deque<std::vector<MRH_Uint8>>& dq_Send = p_Instance->dq_Send;
-    std::deque<std::vector<MRH_Uint8>>& dq_Received = p_Instance->dq_Received;
-    std::mutex& c_SendMutex = p_Instance->c_SendMutex;
-    std::mutex& c_ReceiveMutex = p_Instance->c_ReceiveMutex;
-    int i_Result;
-    
-    // Build stream first
-    c_Logger.Log(MRH_PSBLogger::INFO, "Opening local stream: " + s_FilePath,
-                 "LocalStream.cpp", __LINE__);
-    
-    MRH_LocalStream* p_Stream = MRH_LS_Open(s_FilePath.c_str(), 0);
-    
     if (p_Stream == NULL)
     {
-        c_Logger.Log(MRH_PSBLogger::ERROR, MRH_ERR_GetLocalStreamErrorString(),
-                     "LocalStream.cpp", __LINE__);
-        return;
+        return -1;
     }
     
-    // Now begin exchange
-    MRH_Uint8 p_Send[MRH_STREAM_MESSAGE_TOTAL_SIZE];
-    MRH_Uint8 p_Recieve[MRH_STREAM_MESSAGE_TOTAL_SIZE];
-    MRH_Uint32 u32_SendSize;
-    MRH_Uint32 u32_RecieveSize;
+    MRH_PSBLogger& c_Logger = MRH_PSBLogger::Singleton();
+    int i_Result;
     
-    MRH_LS_M_Version_Data c_Version;
-    c_Version.u32_Version = MRH_STREAM_MESSAGE_VERSION;
+    /**
+     *  Connect
+     */
     
-    while (p_Instance->b_Update == true)
+    if (MRH_LS_GetConnected(p_Stream) < 0)
     {
-        /**
-         *  Connect
-         */
-        
-        if (MRH_LS_GetConnected(p_Stream) < 0)
+        // Switch flag
+        if (b_Connected == true)
         {
-            // Switch flag
-            if (p_Instance->b_Connected == true)
-            {
-                c_Logger.Log(MRH_PSBLogger::INFO, "Local stream client disconnected.",
-                             "LocalStream.cpp", __LINE__);
-                
-                p_Instance->b_Connected = false;
-            }
-            
-            // Attempt to connect
-            if (MRH_LS_Connect(p_Stream) < 0)
-            {
-                // Error?
-                if (MRH_ERR_GetLocalStreamError() != MRH_LOCAL_STREAM_ERROR_UNK)
-                {
-                    c_Logger.Log(MRH_PSBLogger::ERROR, "Connect failed: " + 
-                                                       std::string(MRH_ERR_GetLocalStreamErrorString()), 
-                                 "LocalStream.cpp", __LINE__);
-                    
-                    // Reset is important here, so that simply no partner existing won't throw the
-                    // same error again
-                    MRH_ERR_LocalStreamReset();
-                }
-                
-                // Wait before retry if connection error
-                std::this_thread::sleep_for(std::chrono::seconds(1));
-                continue;
-            }
-            else if (p_Instance->b_Connected == false)
-            {
-                c_Logger.Log(MRH_PSBLogger::INFO, "Local stream client connected.",
-                             "LocalStream.cpp", __LINE__);
-                
-                p_Instance->b_Connected = true;
-            }
+            c_Logger.Log(MRH_PSBLogger::INFO, "Local stream client disconnected (" +
+                                              std::to_string(u32_PartialWrites) +
+                                              " partial writes).",
+                         "LocalStream.cpp", __LINE__);
             
-            // Connected, add version info
-            if (MRH_LS_MessageToBuffer(p_Send, &u32_SendSize, MRH_LS_M_VERSION, &c_Version) < 0)
+            b_Connected = false;
+            c_Reactor.Notify();
+        }
+        
+        u32_VersionSize = 0;
+        u32_PartialWrites = 0;
+        b_ReadBlocked = false;
+        
+        // Attempt to connect
+        if (MRH_LS_Connect(p_Stream) < 0)
+        {
+            // Error?
+            if (MRH_ERR_GetLocalStreamError() != MRH_LOCAL_STREAM_ERROR_UNK)
             {
-                c_Logger.Log(MRH_PSBLogger::ERROR, MRH_ERR_GetLocalStreamErrorString(),
+                c_Logger.Log(MRH_PSBLogger::ERROR, "Connect failed: " + 
+                                                   std::string(MRH_ERR_GetLocalStreamErrorString()), 
                              "LocalStream.cpp", __LINE__);
                 
-                // Reset for connect
+                // Reset is important here, so that simply no partner existing won't throw the
+                // same error again
                 MRH_ERR_LocalStreamReset();
             }
-            else
-            {
-                std::lock_guard<std::mutex> c_Guard(c_SendMutex);
-                dq_Send.emplace_back(p_Send, p_Send + u32_SendSize);
-            }
+            
+            // Wait for a client
+            return LOCAL_STREAM_CONNECT_RETRY_MS;
         }
         
-        /**
-         *  Write
-         */
+        c_Logger.Log(MRH_PSBLogger::INFO, "Local stream client connected.",
+                     "LocalStream.cpp", __LINE__);
+        
+        b_Connected = true;
+        c_Reactor.Notify();
         
-        // Lock
-        c_SendMutex.lock();
+        // Connected, add version info
+        // @NOTE: Version info is always the first message for a client and
+        //        written before the send buffer
+        MRH_LS_M_Version_Data c_Version;
+        c_Version.u32_Version = MRH_STREAM_MESSAGE_VERSION;
         
-        // Now write if possible
-        if (dq_Send.size() > 0)
+        if (MRH_LS_MessageToBuffer(p_Version, &u32_VersionSize, MRH_LS_M_VERSION, &c_Version) < 0)
         {
-            auto& Current = dq_Send.front();
-            i_Result = MRH_LS_Write(p_Stream, Current.data(), Current.size());
+            c_Logger.Log(MRH_PSBLogger::ERROR, MRH_ERR_GetLocalStreamErrorString(),
+                         "LocalStream.cpp", __LINE__);
             
-            if (i_Result < 0)
+            // Reset for connect
+            MRH_ERR_LocalStreamReset();
+            u32_VersionSize = 0;
+        }
+    }
+    
+    /**
+     *  Write
+     */
+    
+    // Version info first, then everything the socket accepts
+    if (u32_VersionSize > 0 && (i_Result = MRH_LS_Write(p_Stream, p_Version, u32_VersionSize)) == 0)
+    {
+        u32_VersionSize = 0;
+    }
+    
+    if (u32_VersionSize == 0)
+    {
+        i_Result = Flush(p_Stream, c_Send);
+    }
+    
+    if (i_Result < 0)
+    {
+        c_Logger.Log(MRH_PSBLogger::ERROR, MRH_ERR_GetLocalStreamErrorString(),
+                     "LocalStream.cpp", __LINE__);
+        
+        // Failed, disconnect and reconnect next update
+        MRH_LS_Disconnect(p_Stream);
+        return 0;
+    }
+    else if (i_Result > 0)
+    {
+        // Socket full, continue once writable
+        ++u32_PartialWrites;
+    }
+    
+    // @NOTE: A full socket is also retried on the next read
+    return LOCAL_STREAM_READ_MS;
+}
+
+void LocalStream::Process() noexcept
+{
+    if (p_Stream == NULL || b_Connected == false)
+    {
+        return;
+    }
+    
+    MRH_PSBLogger& c_Logger = MRH_PSBLogger::Singleton();
+    MRH_Uint8 p_Discard[MRH_STREAM_MESSAGE_TOTAL_SIZE];
+    MRH_Uint32 u32_Size;
+    MRH_Uint32 u32_Received = 0;
+    MRH_Uint32 u32_Dropped = 0;
+    int i_Result;
+    
+    // Add the message kept while the consumer was behind first
+    if (b_ReadBlocked == true)
+    {
+        if (c_Received.Push(c_Read) == false)
+        {
+            return;
+        }
+        
+        b_ReadBlocked = false;
+        ++u32_Received;
+    }
+    
+    /**
+     *  Read
+     */
+    
+    // Read all complete messages, libmrhls might buffer more than one
+    do
+    {
+        // Read directly into a pool buffer, kept for the next read if unused
+        if (c_Read.GetValid() == false)
+        {
+            try
             {
-                c_Logger.Log(MRH_PSBLogger::ERROR, MRH_ERR_GetLocalStreamErrorString(),
-                             "LocalStream.cpp", __LINE__);
-                
-                // Failed, disconnect
-                MRH_LS_Disconnect(p_Stream);
-                continue;
+                c_Read = MessagePool::Singleton().Acquire();
             }
-            else if (i_Result == 0)
+            catch (Exception& e)
             {
-                // Done writing
-                dq_Send.pop_front();
+                c_Logger.Log(MRH_PSBLogger::ERROR, e.what(),
+                             "LocalStream.cpp", __LINE__);
             }
-            // @NOTE: 1 is handled next loop
         }
         
-        // Done, unlock
-        c_SendMutex.unlock();
-        
-        /**
-         *  Read
-         */
-        
-        // Read message data
-        // @NOTE: No loop, skip to writing to empty socket
-        i_Result = MRH_LS_Read(p_Stream, 100, p_Recieve, &u32_RecieveSize);
-        
-        if (i_Result < 0)
+        if (c_Read.GetValid() == false)
         {
-            c_Logger.Log(MRH_PSBLogger::ERROR, MRH_ERR_GetLocalStreamErrorString(),
-                         "LocalStream.cpp", __LINE__);
-            
-            // Failed, disconnect
-            MRH_LS_Disconnect(p_Stream);
-            continue;
+            // No buffer, read to keep the stream going and drop
+            if ((i_Result = MRH_LS_Read(p_Stream, 0, p_Discard, &u32_Size)) == 0)
+            {
+                ++u32_Dropped;
+            }
         }
-        else if (i_Result == 0)
+        else if ((i_Result = MRH_LS_Read(p_Stream, 0, c_Read.GetData(), &u32_Size)) == 0)
         {
-            std::lock_guard<std::mutex> c_Guard(c_ReceiveMutex);
-            dq_Received.emplace_back(p_Recieve, p_Recieve + u32_RecieveSize);
+            c_Read.SetSize(u32_Size);
+            
+            // Keep and stop reading if the consumer is behind
+            if (c_Received.Push(c_Read) == false)
+            {
+                b_ReadBlocked = true;
+                break;
+            }
+            
+            ++u32_Received;
         }
-        // @NOTE: No 1, retry happens after write
     }
+    while (i_Result == 0);
     
-    // Termination, close stream
-    c_Logger.Log(MRH_PSBLogger::INFO, "Local stream terminated.",
-                 "LocalStream.cpp", __LINE__);
+    if (u32_Received > 0)
+    {
+        c_Reactor.Notify();
+    }
     
-    MRH_LS_Close(p_Stream);
+    if (u32_Dropped > 0)
+    {
+        c_Logger.Log(MRH_PSBLogger::WARNING, "No message buffer available, dropped " +
+                                             std::to_string(u32_Dropped) +
+                                             " local stream messages!",
+                     "LocalStream.cpp", __LINE__);
+    }
+    
+    if (i_Result < 0)
+    {
+        c_Logger.Log(MRH_PSBLogger::ERROR, MRH_ERR_GetLocalStreamErrorString(),
+                     "LocalStream.cpp", __LINE__);
+        
+        // Failed, disconnect
+        MRH_LS_Disconnect(p_Stream);
+    }
 }
 
 //*************************************************************************************
@@ -218,50 +341,46 @@ void LocalStream::Update(LocalStream* p_Instance, std::string s_FilePath) noexce
 
 void LocalStream::ClearReceived() noexcept
 {
-    std::lock_guard<std::mutex> c_Guard(c_SendMutex);
-    dq_Received.clear();
-}
-
-void LocalStream::ClearSend() noexcept
-{
-    std::lock_guard<std::mutex> c_Guard(c_SendMutex);
-    dq_Send.clear(); // @NOTE: Local stream write copies, safe to clear all
+    c_Received.Clear();
 }
 
 //*************************************************************************************
 // Send
 //*************************************************************************************
 
-void LocalStream::Send(std::vector<MRH_Uint8>& v_Data)
+bool LocalStream::Send(MessagePool::Buffer& c_Message)
 {
-    try
+    if (c_Message.GetValid() == false || c_Message.GetSize() > MRH_STREAM_MESSAGE_TOTAL_SIZE)
     {
-        std::lock_guard<std::mutex> c_Guard(c_SendMutex);
-        
-        dq_Send.emplace_back();
-        dq_Send.back().swap(v_Data);
-    }
-    catch (std::exception& e)
-    {
-        throw Exception(e.what());
+        throw Exception("Invalid local stream message!");
     }
+    
+    // @NOTE: Never wait for the reactor thread, a full buffer is 
+    //        retried by the caller on the next update
+    bool b_Queued = c_Send.Push(c_Message);
+    
+    // Queued or full, write immediately
+    c_Reactor.Wake();
+    
+    return b_Queued;
 }
 
 //*************************************************************************************
 // Recieve
 //*************************************************************************************
 
-bool LocalStream::Receive(std::vector<MRH_Uint8>& v_Data) noexcept
+bool LocalStream::Receive(MessagePool::Buffer& c_Message) noexcept
 {
-    std::lock_guard<std::mutex> c_Guard(c_ReceiveMutex);
-    
-    if (dq_Received.size() == 0)
+    if (c_Received.Pop(c_Message) == false)
     {
         return false;
     }
     
-    v_Data.swap(dq_Received.front());
-    dq_Received.pop_front();
+    // Space available, continue reading
+    if (b_ReadBlocked == true)
+    {
+        c_Reactor.Wake();
+    }
     
     return true;
 }
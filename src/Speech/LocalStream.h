@@ -18,21 +18,20 @@
 #define LocalStream_h
 
 // C / C++
-#include <thread>
-#include <mutex>
 #include <atomic>
-#include <deque>
-#include <vector>
 
 // External
-#include <libmrhls/MRH_StreamMessage.h>
+#include <libmrhls.h>
 
 // Project
-#include "../Exception.h"
+#include "./LocalStreamReactor.h"
+#include "./MessageRing.h"
 
 
 class LocalStream
 {
+    friend class LocalStreamReactor;
+    
 public:
     
     //*************************************************************************************
@@ -52,28 +51,44 @@ private:
     //*************************************************************************************
     
     /**
-     *  Local stream thread update.
+     *  Connect and write pending messages. Called by the reactor thread.
      *  
-     *  \param p_Instance The local stream instance to update with.
-     *  \param s_FilePath The full path to the local stream socket.
+     *  \return The time in milliseconds until the stream has to be updated again, 
+     *          -1 if only events are required.
      */
     
-    static void Update(LocalStream* p_Instance, std::string s_FilePath) noexcept;
+    int Update() noexcept;
+    
+    /**
+     *  Read available messages. Called by the reactor thread.
+     */
+    
+    void Process() noexcept;
     
     //*************************************************************************************
     // Data
     //*************************************************************************************
     
-    std::thread c_Thread;
-    std::atomic<bool> b_Update;
+    LocalStreamReactor& c_Reactor;
     
-    std::atomic<bool> b_Connected;
+    // Stream
+    // @NOTE: Only used by the reactor thread
+    std::string s_FilePath;
+    MRH_LocalStream* p_Stream;
     
-    std::mutex c_ReceiveMutex;
-    std::deque<std::vector<MRH_Uint8>> dq_Received;
+    MRH_Uint8 p_Version[MRH_STREAM_MESSAGE_TOTAL_SIZE];
+    MRH_Uint32 u32_VersionSize;
+    MessagePool::Buffer c_Read;
     
-    std::mutex c_SendMutex;
-    std::deque<std::vector<MRH_Uint8>> dq_Send;
+    MRH_Uint32 u32_PartialWrites;
+    
+    std::atomic<bool> b_Connected;
+    std::atomic<bool> b_ReadBlocked; // Read message kept, receive buffer full
+    
+    // @NOTE: Single producer and consumer each, the reactor thread 
+    //        produces received and consumes send messages
+    MessageRing c_Received;
+    MessageRing c_Send;
     
 protected:
     
@@ -84,10 +99,12 @@ protected:
     /**
      *  Default constructor.
      *  
+     *  \param c_Reactor The reactor servicing the local stream.
      *  \param s_FilePath The full path to the local stream socket.  
+     *  \param us_RingCapacity The amount of messages buffered for sending and receiving.
      */
     
-    LocalStream(std::string const& s_FilePath);
+    LocalStream(LocalStreamReactor& c_Reactor, std::string const& s_FilePath, size_t us_RingCapacity);
     
     //*************************************************************************************
     // Clear
@@ -99,23 +116,20 @@ protected:
     
     void ClearReceived() noexcept;
     
-    /**
-     *  Clear all send messages.
-     */
-    
-    void ClearSend() noexcept;
-    
     //*************************************************************************************
     // Send
     //*************************************************************************************
     
     /**
-     *  Add a message to send.
+     *  Add a message to send. Returns immediately if the send buffer is full.
      *  
-     *  \param v_Data The message data. The data is consumed.
+     *  \param c_Message The message to send. The message is consumed if added 
+     *                   and kept if not.
+     *
+     *  \return true if added, false if the send buffer is full.
      */
     
-    void Send(std::vector<MRH_Uint8>& v_Data);
+    bool Send(MessagePool::Buffer& c_Message);
     
     //*************************************************************************************
     // Receive
@@ -124,12 +138,12 @@ protected:
     /**
      *  Receive a read message.
      *  
-     *  \param v_Data The received message data.
+     *  \param c_Message The received message. The previous message is released.
      *  
      *  \return true if a message was received, false if not.
      */
     
-    bool Receive(std::vector<MRH_Uint8>& v_Data) noexcept;
+    bool Receive(MessagePool::Buffer& c_Message) noexcept;
     
     //*************************************************************************************
     // Getters
@@ -0,0 +1,198 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+
+// External
+#include <libmrhpsb/MRH_PSBLogger.h>
+
+// Project
+#include "./LocalStreamReactor.h"
+#include "./LocalStream.h"
+
+// Pre-defined
+#define LOCAL_STREAM_REACTOR_EVENT_MAX 16
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+LocalStreamReactor::LocalStreamReactor(Signal& c_Signal) : b_Update(true),
+                                                           i_EpollFD(-1),
+                                                           i_WakeFD(-1),
+                                                           c_Signal(c_Signal)
+{
+    if ((i_EpollFD = epoll_create1(EPOLL_CLOEXEC)) < 0)
+    {
+        throw Exception("Failed to create local stream epoll: " + std::string(std::strerror(errno)));
+    }
+    else if ((i_WakeFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) < 0)
+    {
+        close(i_EpollFD);
+        throw Exception("Failed to create local stream eventfd: " + std::string(std::strerror(errno)));
+    }
+    
+    // @NOTE: Stream sockets are polled, only the wake descriptor is watched
+    struct epoll_event c_Event;
+    c_Event.events = EPOLLIN;
+    c_Event.data.ptr = NULL;
+    
+    if (epoll_ctl(i_EpollFD, EPOLL_CTL_ADD, i_WakeFD, &c_Event) < 0)
+    {
+        close(i_WakeFD);
+        close(i_EpollFD);
+        throw Exception("Failed to watch local stream eventfd: " + std::string(std::strerror(errno)));
+    }
+    
+    try
+    {
+        c_Thread = std::thread(Update, this);
+    }
+    catch (std::exception& e)
+    {
+        close(i_WakeFD);
+        close(i_EpollFD);
+        throw Exception("Failed to start local stream thread: " + std::string(e.what()));
+    }
+}
+
+LocalStreamReactor::~LocalStreamReactor() noexcept
+{
+    b_Update = false;
+    Wake();
+    c_Thread.join();
+    
+    close(i_WakeFD);
+    close(i_EpollFD);
+}
+
+//*************************************************************************************
+// Update
+//*************************************************************************************
+
+void LocalStreamReactor::Update(LocalStreamReactor* p_Instance) noexcept
+{
+    std::vector<LocalStream*>& v_Stream = p_Instance->v_Stream;
+    std::mutex& c_Mutex = p_Instance->c_Mutex;
+    
+    struct epoll_event p_Event[LOCAL_STREAM_REACTOR_EVENT_MAX];
+    MRH_Uint64 u64_Wake;
+    int i_Timeout;
+    int i_StreamTimeout;
+    int i_Result;
+    
+    while (p_Instance->b_Update == true)
+    {
+        /**
+         *  Update
+         */
+        
+        // Connect and write all streams, collect the earliest retry
+        i_Timeout = -1;
+        
+        c_Mutex.lock();
+        
+        for (auto& Stream : v_Stream)
+        {
+            i_StreamTimeout = Stream->Update();
+            
+            if (i_StreamTimeout >= 0 && (i_Timeout < 0 || i_StreamTimeout < i_Timeout))
+            {
+                i_Timeout = i_StreamTimeout;
+            }
+        }
+        
+        c_Mutex.unlock();
+        
+        /**
+         *  Wait
+         */
+        
+        i_Result = epoll_wait(p_Instance->i_EpollFD, p_Event, LOCAL_STREAM_REACTOR_EVENT_MAX, i_Timeout);
+        
+        /**
+         *  Process
+         */
+        
+        // Reset the wake counter
+        if (i_Result > 0)
+        {
+            read(p_Instance->i_WakeFD, &u64_Wake, sizeof(u64_Wake));
+        }
+        
+        std::lock_guard<std::mutex> c_Guard(c_Mutex);
+        
+        for (auto& Stream : v_Stream)
+        {
+            Stream->Process();
+        }
+    }
+}
+
+//*************************************************************************************
+// Streams
+//*************************************************************************************
+
+void LocalStreamReactor::Add(LocalStream* p_Stream)
+{
+    try
+    {
+        std::lock_guard<std::mutex> c_Guard(c_Mutex);
+        v_Stream.emplace_back(p_Stream);
+    }
+    catch (std::exception& e)
+    {
+        throw Exception("Failed to add local stream: " + std::string(e.what()));
+    }
+    
+    Wake();
+}
+
+void LocalStreamReactor::Remove(LocalStream* p_Stream) noexcept
+{
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+    
+    auto Stream = std::find(v_Stream.begin(), v_Stream.end(), p_Stream);
+    
+    if (Stream != v_Stream.end())
+    {
+        v_Stream.erase(Stream);
+    }
+}
+
+//*************************************************************************************
+// Events
+//*************************************************************************************
+
+void LocalStreamReactor::Wake() noexcept
+{
+    MRH_Uint64 u64_Wake = 1;
+    
+    // @NOTE: Failure means the counter is already set, the thread wakes either way
+    write(i_WakeFD, &u64_Wake, sizeof(u64_Wake));
+}
+
+void LocalStreamReactor::Notify() noexcept
+{
+    c_Signal.Notify();
+}
@@ -0,0 +1,131 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef LocalStreamReactor_h
+#define LocalStreamReactor_h
+
+// C / C++
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <vector>
+
+// External
+#include <MRH_Typedefs.h>
+
+// Project
+#include "./Signal.h"
+#include "../Exception.h"
+
+// Pre-declared
+class LocalStream;
+
+
+class LocalStreamReactor
+{
+    friend class LocalStream;
+    
+public:
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     *
+     *  \param c_Signal The signal notified on stream input and connection changes.
+     */
+    
+    LocalStreamReactor(Signal& c_Signal);
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~LocalStreamReactor() noexcept;
+    
+private:
+    
+    //*************************************************************************************
+    // Update
+    //*************************************************************************************
+    
+    /**
+     *  Reactor thread update.
+     *  
+     *  \param p_Instance The reactor instance to update with.
+     */
+    
+    static void Update(LocalStreamReactor* p_Instance) noexcept;
+    
+    //*************************************************************************************
+    // Streams
+    //*************************************************************************************
+    
+    /**
+     *  Add a local stream to service. This function is thread safe.
+     *  
+     *  \param p_Stream The local stream to add.
+     */
+    
+    void Add(LocalStream* p_Stream);
+    
+    /**
+     *  Remove a local stream. The stream is no longer used once this function 
+     *  returns. This function is thread safe.
+     *  
+     *  \param p_Stream The local stream to remove.
+     */
+    
+    void Remove(LocalStream* p_Stream) noexcept;
+    
+    //*************************************************************************************
+    // Events
+    //*************************************************************************************
+    
+    /**
+     *  Wake the reactor thread from waiting for events. This function is thread safe.
+     */
+    
+    void Wake() noexcept;
+    
+    /**
+     *  Notify the stream user about new input or a connection change.
+     */
+    
+    void Notify() noexcept;
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    std::thread c_Thread;
+    std::atomic<bool> b_Update;
+    
+    int i_EpollFD;
+    int i_WakeFD;
+    
+    std::mutex c_Mutex;
+    std::vector<LocalStream*> v_Stream;
+    
+    Signal& c_Signal;
+    
+protected:
+    
+};
+
+#endif /* LocalStreamReactor_h */
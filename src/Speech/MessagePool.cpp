@@ -0,0 +1,183 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+
+// External
+
+// Project
+#include "./MessagePool.h"
+#include "../Metrics.h"
+
+// Pre-defined
+#ifndef MRH_SPEECH_MESSAGE_POOL_SLAB_SIZE
+    #define MRH_SPEECH_MESSAGE_POOL_SLAB_SIZE 64
+#endif
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+MessagePool::MessagePool() noexcept : p_Free(NULL),
+                                      us_Used(0)
+{}
+
+MessagePool::~MessagePool() noexcept
+{}
+
+MessagePool::Buffer::Buffer() noexcept : p_Block(NULL)
+{}
+
+MessagePool::Buffer::Buffer(Block* p_Block) noexcept : p_Block(p_Block)
+{}
+
+MessagePool::Buffer::Buffer(Buffer&& c_Buffer) noexcept : p_Block(c_Buffer.p_Block)
+{
+    c_Buffer.p_Block = NULL;
+}
+
+MessagePool::Buffer::~Buffer() noexcept
+{
+    Release();
+}
+
+//*************************************************************************************
+// Singleton
+//*************************************************************************************
+
+MessagePool& MessagePool::Singleton() noexcept
+{
+    static MessagePool c_MessagePool;
+    return c_MessagePool;
+}
+
+//*************************************************************************************
+// Operator
+//*************************************************************************************
+
+MessagePool::Buffer& MessagePool::Buffer::operator=(Buffer&& c_Buffer) noexcept
+{
+    if (this != &c_Buffer)
+    {
+        Release();
+        
+        p_Block = c_Buffer.p_Block;
+        c_Buffer.p_Block = NULL;
+    }
+    
+    return *this;
+}
+
+//*************************************************************************************
+// Acquire
+//*************************************************************************************
+
+MessagePool::Buffer MessagePool::Acquire()
+{
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+    
+    if (p_Free != NULL)
+    {
+        Metrics::Singleton().Add(Metrics::MESSAGE_POOL_HIT);
+    }
+    else
+    {
+        // Empty, grow by a full slab
+        try
+        {
+            v_Slab.emplace_back(new Block[MRH_SPEECH_MESSAGE_POOL_SLAB_SIZE]);
+        }
+        catch (std::exception& e)
+        {
+            throw Exception("Failed to grow message pool: " + std::string(e.what()));
+        }
+        
+        Block* p_Slab = v_Slab.back().get();
+        
+        for (size_t i = 0; i < MRH_SPEECH_MESSAGE_POOL_SLAB_SIZE; ++i)
+        {
+            p_Slab[i].p_Next = p_Free;
+            p_Free = &(p_Slab[i]);
+        }
+        
+        Metrics::Singleton().Add(Metrics::MESSAGE_POOL_MISS);
+    }
+    
+    Block* p_Block = p_Free;
+    p_Free = p_Block->p_Next;
+    p_Block->u32_Size = 0;
+    
+    Metrics::Singleton().SetMax(Metrics::MESSAGE_POOL_HIGH_WATER, ++us_Used);
+    
+    return Buffer(p_Block);
+}
+
+//*************************************************************************************
+// Release
+//*************************************************************************************
+
+void MessagePool::Release(Block* p_Block) noexcept
+{
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+    
+    p_Block->p_Next = p_Free;
+    p_Free = p_Block;
+    
+    --us_Used;
+}
+
+void MessagePool::Buffer::Release() noexcept
+{
+    if (p_Block != NULL)
+    {
+        MessagePool::Singleton().Release(p_Block);
+        p_Block = NULL;
+    }
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+bool MessagePool::Buffer::GetValid() const noexcept
+{
+    return p_Block != NULL ? true : false;
+}
+
+MRH_Uint8* MessagePool::Buffer::GetData() noexcept
+{
+    return p_Block->p_Data;
+}
+
+const MRH_Uint8* MessagePool::Buffer::GetData() const noexcept
+{
+    return p_Block->p_Data;
+}
+
+MRH_Uint32 MessagePool::Buffer::GetSize() const noexcept
+{
+    return p_Block->u32_Size;
+}
+
+//*************************************************************************************
+// Setters
+//*************************************************************************************
+
+void MessagePool::Buffer::SetSize(MRH_Uint32 u32_Size) noexcept
+{
+    p_Block->u32_Size = u32_Size;
+}
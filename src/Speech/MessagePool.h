@@ -0,0 +1,244 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef MessagePool_h
+#define MessagePool_h
+
+// C / C++
+#include <mutex>
+#include <vector>
+#include <memory>
+
+// External
+#include <libmrhls/MRH_StreamMessage.h>
+
+// Project
+#include "../Exception.h"
+
+
+class MessagePool
+{
+private:
+    
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+    
+    struct Block
+    {
+        Block* p_Next;
+        MRH_Uint32 u32_Size;
+        MRH_Uint8 p_Data[MRH_STREAM_MESSAGE_TOTAL_SIZE];
+    };
+    
+public:
+    
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+    
+    class Buffer
+    {
+        friend class MessagePool;
+        
+    public:
+        
+        //*************************************************************************************
+        // Constructor / Destructor
+        //*************************************************************************************
+        
+        /**
+         *  Default constructor. The buffer is empty until acquired.
+         */
+        
+        Buffer() noexcept;
+        
+        /**
+         *  Move constructor.
+         *
+         *  \param c_Buffer The buffer to take the pool block from.
+         */
+        
+        Buffer(Buffer&& c_Buffer) noexcept;
+        
+        /**
+         *  Default destructor. The pool block is returned to the pool.
+         */
+        
+        ~Buffer() noexcept;
+        
+        //*************************************************************************************
+        // Operator
+        //*************************************************************************************
+        
+        /**
+         *  Move assignment. The current pool block is returned to the pool.
+         *
+         *  \param c_Buffer The buffer to take the pool block from.
+         *
+         *  \return The buffer.
+         */
+        
+        Buffer& operator=(Buffer&& c_Buffer) noexcept;
+        
+        //*************************************************************************************
+        // Release
+        //*************************************************************************************
+        
+        /**
+         *  Return the pool block to the pool.
+         */
+        
+        void Release() noexcept;
+        
+        //*************************************************************************************
+        // Getters
+        //*************************************************************************************
+        
+        /**
+         *  Check if the buffer holds a pool block.
+         *
+         *  \return true if valid, false if not.
+         */
+        
+        bool GetValid() const noexcept;
+        
+        /**
+         *  Get the message data with MRH_STREAM_MESSAGE_TOTAL_SIZE bytes.
+         *
+         *  \return The message data.
+         */
+        
+        MRH_Uint8* GetData() noexcept;
+        
+        /**
+         *  Get the message data with MRH_STREAM_MESSAGE_TOTAL_SIZE bytes.
+         *
+         *  \return The message data.
+         */
+        
+        const MRH_Uint8* GetData() const noexcept;
+        
+        /**
+         *  Get the size of the stored message.
+         *
+         *  \return The message size in bytes.
+         */
+        
+        MRH_Uint32 GetSize() const noexcept;
+        
+        //*************************************************************************************
+        // Setters
+        //*************************************************************************************
+        
+        /**
+         *  Set the size of the stored message.
+         *
+         *  \param u32_Size The message size in bytes.
+         */
+        
+        void SetSize(MRH_Uint32 u32_Size) noexcept;
+        
+    private:
+        
+        //*************************************************************************************
+        // Constructor
+        //*************************************************************************************
+        
+        /**
+         *  Block constructor.
+         *
+         *  \param p_Block The owned pool block.
+         */
+        
+        Buffer(Block* p_Block) noexcept;
+        
+        //*************************************************************************************
+        // Data
+        //*************************************************************************************
+        
+        Block* p_Block;
+    };
+    
+    //*************************************************************************************
+    // Singleton
+    //*************************************************************************************
+    
+    /**
+     *  Get the class instance. This function is thread safe.
+     *
+     *  \return The class instance.
+     */
+    
+    static MessagePool& Singleton() noexcept;
+    
+    //*************************************************************************************
+    // Acquire
+    //*************************************************************************************
+    
+    /**
+     *  Acquire a message buffer. This function is thread safe.
+     *
+     *  \return The message buffer.
+     */
+    
+    Buffer Acquire();
+    
+private:
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     */
+    
+    MessagePool() noexcept;
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~MessagePool() noexcept;
+    
+    //*************************************************************************************
+    // Release
+    //*************************************************************************************
+    
+    /**
+     *  Return a pool block to the pool. This function is thread safe.
+     *
+     *  \param p_Block The pool block to return.
+     */
+    
+    void Release(Block* p_Block) noexcept;
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    std::mutex c_Mutex;
+    Block* p_Free;
+    std::vector<std::unique_ptr<Block[]>> v_Slab;
+    
+    size_t us_Used;
+    
+protected:
+    
+};
+
+#endif /* MessagePool_h */
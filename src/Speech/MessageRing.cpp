@@ -0,0 +1,148 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <utility>
+
+// External
+
+// Project
+#include "./MessageRing.h"
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+MessageRing::MessageRing(size_t us_Capacity) : us_Head(0),
+                                               us_TailCache(0),
+                                               us_Tail(0),
+                                               us_HeadCache(0)
+{
+    if (us_Capacity == 0)
+    {
+        throw Exception("Invalid message ring capacity!");
+    }
+    
+    // Power of two, index wrap is a mask
+    size_t us_Slots = 1;
+    
+    while (us_Slots < us_Capacity)
+    {
+        us_Slots <<= 1;
+    }
+    
+    us_Mask = us_Slots - 1;
+    
+    try
+    {
+        v_Slot.resize(us_Slots);
+    }
+    catch (std::exception& e)
+    {
+        throw Exception("Failed to allocate message ring: " + std::string(e.what()));
+    }
+}
+
+MessageRing::~MessageRing() noexcept
+{}
+
+//*************************************************************************************
+// Producer
+//*************************************************************************************
+
+bool MessageRing::Push(MessagePool::Buffer& c_Message) noexcept
+{
+    size_t us_Current = us_Tail.load(std::memory_order_relaxed);
+    
+    if ((us_Current - us_HeadCache) > us_Mask)
+    {
+        // Seems full, check consumer progress
+        us_HeadCache = us_Head.load(std::memory_order_acquire);
+        
+        if ((us_Current - us_HeadCache) > us_Mask)
+        {
+            return false;
+        }
+    }
+    
+    v_Slot[us_Current & us_Mask] = std::move(c_Message);
+    us_Tail.store(us_Current + 1, std::memory_order_release);
+    
+    return true;
+}
+
+//*************************************************************************************
+// Consumer
+//*************************************************************************************
+
+MessagePool::Buffer* MessageRing::GetRead() noexcept
+{
+    size_t us_Current = us_Head.load(std::memory_order_relaxed);
+    
+    if (us_Current == us_TailCache)
+    {
+        // Seems empty, check producer progress
+        us_TailCache = us_Tail.load(std::memory_order_acquire);
+        
+        if (us_Current == us_TailCache)
+        {
+            return NULL;
+        }
+    }
+    
+    return &(v_Slot[us_Current & us_Mask]);
+}
+
+void MessageRing::Pop() noexcept
+{
+    size_t us_Current = us_Head.load(std::memory_order_relaxed);
+    
+    v_Slot[us_Current & us_Mask].Release();
+    us_Head.store(us_Current + 1, std::memory_order_release);
+}
+
+bool MessageRing::Pop(MessagePool::Buffer& c_Message) noexcept
+{
+    MessagePool::Buffer* p_Message = GetRead();
+    
+    if (p_Message == NULL)
+    {
+        return false;
+    }
+    
+    c_Message = std::move(*p_Message);
+    us_Head.store(us_Head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    
+    return true;
+}
+
+void MessageRing::Clear() noexcept
+{
+    while (GetRead() != NULL)
+    {
+        Pop();
+    }
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+size_t MessageRing::GetCapacity() const noexcept
+{
+    return us_Mask + 1;
+}
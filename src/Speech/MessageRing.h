@@ -0,0 +1,145 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef MessageRing_h
+#define MessageRing_h
+
+// C / C++
+#include <atomic>
+#include <vector>
+
+// External
+
+// Project
+#include "./MessagePool.h"
+
+// Pre-defined
+#ifndef MRH_SPEECH_CACHE_LINE_SIZE
+    #define MRH_SPEECH_CACHE_LINE_SIZE 64
+#endif
+
+
+class MessageRing
+{
+public:
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     *
+     *  \param us_Capacity The amount of messages the ring can hold. Rounded up to 
+     *                     the next power of two.
+     */
+    
+    MessageRing(size_t us_Capacity);
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~MessageRing() noexcept;
+    
+    //*************************************************************************************
+    // Producer
+    //*************************************************************************************
+    
+    /**
+     *  Add a message. Only usable by the producer thread.
+     *
+     *  \param c_Message The message to add. The message is consumed on success.
+     *
+     *  \return true if added, false if the ring is full.
+     */
+    
+    bool Push(MessagePool::Buffer& c_Message) noexcept;
+    
+    //*************************************************************************************
+    // Consumer
+    //*************************************************************************************
+    
+    /**
+     *  Get the oldest message without removing it. Only usable by the consumer thread.
+     *
+     *  \return The message on success, NULL if the ring is empty.
+     */
+    
+    MessagePool::Buffer* GetRead() noexcept;
+    
+    /**
+     *  Remove the oldest message and return it to the pool. Only usable by the 
+     *  consumer thread.
+     */
+    
+    void Pop() noexcept;
+    
+    /**
+     *  Remove the oldest message. Only usable by the consumer thread.
+     *
+     *  \param c_Message The removed message.
+     *
+     *  \return true if a message was removed, false if the ring is empty.
+     */
+    
+    bool Pop(MessagePool::Buffer& c_Message) noexcept;
+    
+    /**
+     *  Remove all messages. Only usable by the consumer thread.
+     */
+    
+    void Clear() noexcept;
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the amount of messages the ring can hold.
+     *
+     *  \return The ring capacity.
+     */
+    
+    size_t GetCapacity() const noexcept;
+    
+private:
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    // @NOTE: Producer and consumer indices are kept on separate cache lines, 
+    //        each side caches the index of the other to avoid sharing lines
+    //        on every access
+    MRH_Uint8 p_PaddingStart[MRH_SPEECH_CACHE_LINE_SIZE];
+    
+    std::atomic<size_t> us_Head; // Consumer
+    size_t us_TailCache;
+    MRH_Uint8 p_PaddingHead[MRH_SPEECH_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+    
+    std::atomic<size_t> us_Tail; // Producer
+    size_t us_HeadCache;
+    MRH_Uint8 p_PaddingTail[MRH_SPEECH_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+    
+    size_t us_Mask;
+    std::vector<MessagePool::Buffer> v_Slot;
+    
+protected:
+    
+};
+
+#endif /* MessageRing_h */
@@ -33,7 +33,7 @@
 // Constructor / Destructor
 //*************************************************************************************
 
-OutputStorage::OutputStorage() noexcept
+OutputStorage::OutputStorage(Signal& c_Signal) noexcept : c_Signal(c_Signal)
 {}
 
 OutputStorage::~OutputStorage() noexcept
@@ -94,7 +94,11 @@ void OutputStorage::AddString(MRH_EvD_S_String_U const& c_String, MRH_Uint32 u32
     {
         MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::ERROR, e.what(),
                                        "OutputStorage.cpp", __LINE__);
+        return;
     }
+    
+    // Added, process immediately
+    c_Signal.Notify();
 }
 
 //*************************************************************************************
@@ -25,6 +25,7 @@
 #include <libmrhevdata/Version/1/MRH_EvSay_V1.h>
 
 // Project
+#include "./Signal.h"
 #include "../Exception.h"
 
 
@@ -71,9 +72,11 @@ public:
     
     /**
      *  Default constructor.
+     *
+     *  \param c_Signal The signal notified when output is added.
      */
     
-    OutputStorage() noexcept;
+    OutputStorage(Signal& c_Signal) noexcept;
     
     /**
      *  Default destructor.
@@ -133,6 +136,8 @@ private:
     std::mutex c_Mutex;
     std::deque<String> dq_Output; // UTF-8
     
+    Signal& c_Signal;
+    
 protected:
 
 };
@@ -0,0 +1,376 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef RequestStage_h
+#define RequestStage_h
+
+// C / C++
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+
+// External
+#include <libmrhpsb/MRH_PSBLogger.h>
+
+// Project
+#include "./Signal.h"
+#include "../Exception.h"
+
+
+template<typename Job, typename Result>
+class RequestStage
+{
+public:
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     *
+     *  \param c_Signal The signal notified when a request completed.
+     *  \param u32_MaxActive The maximum amount of requests active at the same time.
+     */
+    
+    RequestStage(Signal& c_Signal, MRH_Uint32 u32_MaxActive) noexcept : b_Update(true),
+                                                                       b_Starting(false),
+                                                                       u32_Active(0),
+                                                                       u32_MaxActive(u32_MaxActive > 0 ? u32_MaxActive : 1),
+                                                                       u64_FrontSequence(0),
+                                                                       u64_NextSequence(0),
+                                                                       c_Signal(c_Signal)
+    {}
+    
+    /**
+     *  Default destructor.
+     *
+     *  \note Stage implementations have to call Stop() in their own destructor.
+     */
+    
+    virtual ~RequestStage() noexcept
+    {}
+    
+    //*************************************************************************************
+    // Stop
+    //*************************************************************************************
+    
+    /**
+     *  Cancel all active requests and wait for their completion. No requests 
+     *  are started afterwards.
+     */
+    
+    void Stop() noexcept
+    {
+        std::unique_lock<std::mutex> c_Lock(c_Mutex);
+        
+        b_Update = false;
+        dq_Job.clear();
+        
+        Cancel();
+        
+        c_Condition.wait(c_Lock, [this]()
+        {
+            return u32_Active == 0 && b_Starting == false;
+        });
+    }
+    
+    //*************************************************************************************
+    // Clear
+    //*************************************************************************************
+    
+    /**
+     *  Discard all queued jobs and results and cancel all active requests. 
+     *  This function is thread safe.
+     */
+    
+    void Clear() noexcept
+    {
+        std::lock_guard<std::mutex> c_Guard(c_Mutex);
+        
+        dq_Job.clear();
+        dq_Result.clear();
+        
+        u64_FrontSequence = u64_NextSequence;
+        
+        // @NOTE: Cancelled requests complete with a sequence in front 
+        //        of the current one and are discarded
+        Cancel();
+    }
+    
+    //*************************************************************************************
+    // Add
+    //*************************************************************************************
+    
+    /**
+     *  Add a job to perform. This function is thread safe.
+     *
+     *  \param c_Job The job to add. The job is moved.
+     */
+    
+    void Add(Job&& c_Job)
+    {
+        std::unique_lock<std::mutex> c_Lock(c_Mutex);
+        
+        if (b_Update == false)
+        {
+            throw Exception("Request stage stopped!");
+        }
+        
+        try
+        {
+            dq_Job.emplace_back(u64_NextSequence, std::move(c_Job));
+            dq_Result.emplace_back();
+            
+            ++u64_NextSequence;
+        }
+        catch (std::exception& e)
+        {
+            throw Exception("Failed to add stage job: " + std::string(e.what()));
+        }
+        
+        // Start now if possible, otherwise on the next completion
+        Start(c_Lock);
+    }
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the next result in the order the jobs were added. Failed jobs are 
+     *  skipped. This function is thread safe.
+     *
+     *  \param c_Result The result to move the next result to.
+     *
+     *  \return true if a result was set, false if not.
+     */
+    
+    bool GetResult(Result& c_Result) noexcept
+    {
+        std::lock_guard<std::mutex> c_Guard(c_Mutex);
+        
+        while (dq_Result.size() > 0 && dq_Result.front().b_Done == true)
+        {
+            std::unique_ptr<Result> p_Result(std::move(dq_Result.front().p_Result));
+            
+            dq_Result.pop_front();
+            ++u64_FrontSequence;
+            
+            if (p_Result)
+            {
+                c_Result = std::move(*p_Result);
+                return true;
+            }
+        }
+        
+        return false;
+    }
+    
+    /**
+     *  Get the amount of jobs which were added but not yet returned as a result. 
+     *  This function is thread safe.
+     *
+     *  \return The pending job count.
+     */
+    
+    size_t GetPending() noexcept
+    {
+        std::lock_guard<std::mutex> c_Guard(c_Mutex);
+        return dq_Result.size();
+    }
+    
+private:
+    
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+    
+    struct Slot
+    {
+        Slot() noexcept : b_Done(false)
+        {}
+        
+        bool b_Done;
+        std::unique_ptr<Result> p_Result; // NULL on failure
+    };
+    
+    //*************************************************************************************
+    // Start
+    //*************************************************************************************
+    
+    /**
+     *  Start queued jobs until all requests are active. Only one thread 
+     *  starts jobs at a time, jobs queued or requests finished while 
+     *  starting are picked up by the starting thread.
+     *
+     *  \param c_Lock The locked stage lock.
+     */
+    
+    void Start(std::unique_lock<std::mutex>& c_Lock) noexcept
+    {
+        // @NOTE: Requests completing while performing end up here, 
+        //        the loop keeps the stack flat for synchronous completions
+        if (b_Starting == true)
+        {
+            return;
+        }
+        
+        b_Starting = true;
+        
+        while (b_Update == true && dq_Job.size() > 0 && u32_Active < u32_MaxActive)
+        {
+            MRH_Uint64 u64_Sequence = dq_Job.front().first;
+            Job c_Job(std::move(dq_Job.front().second));
+            dq_Job.pop_front();
+            
+            ++u32_Active;
+            
+            // @NOTE: Requests might complete while starting, never hold 
+            //        the lock when performing
+            c_Lock.unlock();
+            
+            try
+            {
+                Perform(u64_Sequence, c_Job);
+            }
+            catch (std::exception& e)
+            {
+                MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::ERROR, e.what(),
+                                               "RequestStage.h", __LINE__);
+                Fail(u64_Sequence);
+            }
+            
+            c_Lock.lock();
+        }
+        
+        // @NOTE: The stage might be destroyed once nothing is starting,
+        //        nothing is accessed after unlocking
+        b_Starting = false;
+        c_Condition.notify_all();
+    }
+    
+    /**
+     *  Store the result of a request and start the next queued job.
+     *
+     *  \param u64_Sequence The sequence of the completed job.
+     *  \param p_Result The job result, NULL on failure.
+     */
+    
+    void Finish(MRH_Uint64 u64_Sequence, std::unique_ptr<Result> p_Result) noexcept
+    {
+        std::unique_lock<std::mutex> c_Lock(c_Mutex);
+        
+        // Store result if not cleared in the meantime
+        if (u64_Sequence >= u64_FrontSequence)
+        {
+            Slot& c_Slot = dq_Result[u64_Sequence - u64_FrontSequence];
+            
+            c_Slot.p_Result = std::move(p_Result);
+            c_Slot.b_Done = true;
+            
+            c_Signal.Notify();
+        }
+        
+        --u32_Active;
+        
+        // Start the next job, returns if already starting
+        Start(c_Lock);
+    }
+    
+    //*************************************************************************************
+    // Perform
+    //*************************************************************************************
+    
+    /**
+     *  Start a request for a job. The request has to call Complete() or Fail() 
+     *  exactly once when finished, which might happen before returning.
+     *
+     *  \param u64_Sequence The sequence of the job.
+     *  \param c_Job The job to perform.
+     */
+    
+    virtual void Perform(MRH_Uint64 u64_Sequence, Job& c_Job) = 0;
+    
+    /**
+     *  Cancel all active requests. Cancelled requests still have to complete.
+     */
+    
+    virtual void Cancel() noexcept = 0;
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    std::mutex c_Mutex;
+    std::condition_variable c_Condition;
+    
+    bool b_Update;
+    bool b_Starting;
+    MRH_Uint32 u32_Active;
+    MRH_Uint32 u32_MaxActive;
+    
+    std::deque<std::pair<MRH_Uint64, Job>> dq_Job;
+    std::deque<Slot> dq_Result;
+    MRH_Uint64 u64_FrontSequence;
+    MRH_Uint64 u64_NextSequence;
+    
+    Signal& c_Signal;
+    
+protected:
+    
+    //*************************************************************************************
+    // Complete
+    //*************************************************************************************
+    
+    /**
+     *  Complete a request with a result. This function is thread safe.
+     *
+     *  \param u64_Sequence The sequence of the job.
+     *  \param c_Result The job result. The result is moved.
+     */
+    
+    void Complete(MRH_Uint64 u64_Sequence, Result&& c_Result) noexcept
+    {
+        std::unique_ptr<Result> p_Result;
+        
+        try
+        {
+            p_Result.reset(new Result(std::move(c_Result)));
+        }
+        catch (std::exception& e)
+        {
+            MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::ERROR, e.what(),
+                                           "RequestStage.h", __LINE__);
+        }
+        
+        Finish(u64_Sequence, std::move(p_Result));
+    }
+    
+    /**
+     *  Complete a request without a result. This function is thread safe.
+     *
+     *  \param u64_Sequence The sequence of the job.
+     */
+    
+    void Fail(MRH_Uint64 u64_Sequence) noexcept
+    {
+        Finish(u64_Sequence, std::unique_ptr<Result>());
+    }
+};
+
+#endif /* RequestStage_h */
@@ -0,0 +1,65 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <chrono>
+
+// External
+
+// Project
+#include "./Signal.h"
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+Signal::Signal() noexcept : b_Notified(false)
+{}
+
+Signal::~Signal() noexcept
+{}
+
+//*************************************************************************************
+// Notify
+//*************************************************************************************
+
+void Signal::Notify() noexcept
+{
+    {
+        std::lock_guard<std::mutex> c_Guard(c_Mutex);
+        b_Notified = true;
+    }
+    
+    c_Condition.notify_one();
+}
+
+//*************************************************************************************
+// Wait
+//*************************************************************************************
+
+bool Signal::Wait(MRH_Uint32 u32_TimeoutMS) noexcept
+{
+    std::unique_lock<std::mutex> c_Lock(c_Mutex);
+    
+    bool b_Result = c_Condition.wait_for(c_Lock, 
+                                         std::chrono::milliseconds(u32_TimeoutMS), 
+                                         [this]() { return b_Notified; });
+    
+    // Consumed, all notifications until now are handled by the caller
+    b_Notified = false;
+    return b_Result;
+}
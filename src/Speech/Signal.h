@@ -0,0 +1,89 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef Signal_h
+#define Signal_h
+
+// C / C++
+#include <mutex>
+#include <condition_variable>
+
+// External
+#include <MRH_Typedefs.h>
+
+// Project
+
+
+class Signal
+{
+public:
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     */
+    
+    Signal() noexcept;
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~Signal() noexcept;
+    
+    //*************************************************************************************
+    // Notify
+    //*************************************************************************************
+    
+    /**
+     *  Wake the waiting thread. Notifications while no thread is waiting are kept 
+     *  for the next wait. This function is thread safe.
+     */
+    
+    void Notify() noexcept;
+    
+    //*************************************************************************************
+    // Wait
+    //*************************************************************************************
+    
+    /**
+     *  Wait for a notification. This function is thread safe.
+     *
+     *  \param u32_TimeoutMS The maximum time to wait in milliseconds.
+     *
+     *  \return true if notified, false if the wait timed out.
+     */
+    
+    bool Wait(MRH_Uint32 u32_TimeoutMS) noexcept;
+    
+private:
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    std::mutex c_Mutex;
+    std::condition_variable c_Condition;
+    bool b_Notified;
+    
+protected:
+    
+};
+
+#endif /* Signal_h */
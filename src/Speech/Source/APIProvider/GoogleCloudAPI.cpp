@@ -15,20 +15,40 @@
  */
 
 // C / C++
+#include <atomic>
 
 // External
 #include <google/cloud/speech/v1/cloud_speech.grpc.pb.h>
 #include <google/cloud/texttospeech/v1/cloud_tts.grpc.pb.h>
 #include <google/longrunning/operations.grpc.pb.h>
 #include <grpcpp/grpcpp.h>
+#include <grpcpp/alarm.h>
 #include <libmrhpsb/MRH_PSBLogger.h>
 
 // Project
 #include "./GoogleCloudAPI.h"
 #include "../../../Configuration.h"
+#include "../../../Metrics.h"
 
 // Pre-defined
 #define AUDIO_WRITE_SIZE_ELEMENTS 32 * 1024 // Google recommends 64 * 1024 in bytes, so /2 for PCM16 elements
+#ifndef MRH_SPEECH_GOOGLE_CONNECTION_CHECK_MS
+    #define MRH_SPEECH_GOOGLE_CONNECTION_CHECK_MS 1000
+#endif
+#ifndef MRH_SPEECH_GOOGLE_CONNECTION_WARM_UP_MS
+    #define MRH_SPEECH_GOOGLE_CONNECTION_WARM_UP_MS 5000
+#endif
+#ifndef MRH_SPEECH_GOOGLE_CONNECTION_RETRY_MS
+    #define MRH_SPEECH_GOOGLE_CONNECTION_RETRY_MS 30000
+#endif
+#ifndef MRH_SPEECH_GOOGLE_KEEPALIVE_MIN_MS
+    #define MRH_SPEECH_GOOGLE_KEEPALIVE_MIN_MS 300000 // Google frontends reject more frequent idle pings
+#endif
+#ifndef MRH_SPEECH_GOOGLE_STREAM_LIMIT_MS
+    #define MRH_SPEECH_GOOGLE_STREAM_LIMIT_MS 300000 // Streams are limited to 5 minutes
+#endif
+#define GOOGLE_SPEECH_TARGET "speech.googleapis.com"
+#define GOOGLE_TEXT_TO_SPEECH_TARGET "texttospeech.googleapis.com"
 
 using google::cloud::texttospeech::v1::TextToSpeech;
 using google::cloud::texttospeech::v1::SynthesizeSpeechRequest;
@@ -41,174 +61,1329 @@ using google::cloud::speech::v1::RecognizeRequest;
 using google::cloud::speech::v1::RecognizeResponse;
 using google::cloud::speech::v1::RecognitionConfig;
 using google::cloud::speech::v1::StreamingRecognitionResult;
+using google::cloud::speech::v1::StreamingRecognizeRequest;
+using google::cloud::speech::v1::StreamingRecognizeResponse;
+
+using GoogleCloudAPI::Client;
 
 
 //*************************************************************************************
-// Transcribe
+// Connection
 //*************************************************************************************
 
-std::string GoogleCloudAPI::Transcribe(AudioBuffer const& c_Audio, std::string s_LangCode)
+class Client::Connection
 {
-    // Audio available?
-    if (c_Audio.GetSampleCount() == 0)
+public:
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor. The channels start connecting immediately.
+     *
+     *  \param u32_KeepaliveMS The HTTP/2 keepalive ping interval in milliseconds.
+     */
+    
+    Connection(MRH_Uint32 u32_KeepaliveMS)
     {
-        throw Exception("No audio to transcribe added!");
+        /**
+         *  Credentials Setup
+         */
+        
+        // @NOTE: Google speech api is accessed as shown here:
+        //        https://github.com/GoogleCloudPlatform/cpp-samples/blob/main/speech/api/transcribe.cc
+        
+        // Credentials are shared by both channels, access tokens are 
+        // refreshed by grpc
+        auto c_Credentials = grpc::GoogleDefaultCredentials();
+        
+        if (c_Credentials == nullptr)
+        {
+            throw Exception("Failed to find google default credentials!");
+        }
+        
+        // Keep idle connections open, no handshake on the next request
+        grpc::ChannelArguments c_Arguments;
+        
+        if (u32_KeepaliveMS > 0)
+        {
+            c_Arguments.SetInt(GRPC_ARG_KEEPALIVE_TIME_MS, static_cast<int>(u32_KeepaliveMS));
+            c_Arguments.SetInt(GRPC_ARG_KEEPALIVE_TIMEOUT_MS, 10000);
+            c_Arguments.SetInt(GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS, 1);
+            c_Arguments.SetInt(GRPC_ARG_HTTP2_MAX_PINGS_WITHOUT_DATA, 0);
+        }
+        
+        p_SpeechChannel = grpc::CreateCustomChannel(GOOGLE_SPEECH_TARGET, c_Credentials, c_Arguments);
+        p_TextToSpeechChannel = grpc::CreateCustomChannel(GOOGLE_TEXT_TO_SPEECH_TARGET, c_Credentials, c_Arguments);
+        
+        p_Speech = Speech::NewStub(p_SpeechChannel);
+        p_TextToSpeech = TextToSpeech::NewStub(p_TextToSpeechChannel);
+        
+        // Start connecting now
+        p_SpeechChannel->GetState(true);
+        p_TextToSpeechChannel->GetState(true);
     }
     
+    //*************************************************************************************
+    // Connect
+    //*************************************************************************************
+    
     /**
-     *  Credentials Setup
+     *  Wait for both channels to be connected.
+     *
+     *  \param u32_TimeoutMS The maximum time to wait in milliseconds.
+     *
+     *  \return true if connected, false if not.
      */
     
-    // @NOTE: Google speech api is accessed as shown here:
-    //        https://github.com/GoogleCloudPlatform/cpp-samples/blob/main/speech/api/transcribe.cc
+    bool WaitForConnected(MRH_Uint32 u32_TimeoutMS) noexcept
+    {
+        auto c_Deadline = std::chrono::system_clock::now() + std::chrono::milliseconds(u32_TimeoutMS);
+        
+        return p_SpeechChannel->WaitForConnected(c_Deadline) == true && 
+               p_TextToSpeechChannel->WaitForConnected(c_Deadline) == true;
+    }
     
-    // Setup google connection with credentials for this request
-    auto c_Credentials = grpc::GoogleDefaultCredentials();
-    auto c_CloudChannel = grpc::CreateChannel("speech.googleapis.com", c_Credentials);
-    std::unique_ptr<Speech::Stub> p_Speech(Speech::NewStub(c_CloudChannel));
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
     
     /**
-     *  Create Request
+     *  Check if a channel failed. Idle channels are asked to connect.
+     *
+     *  \return true if failed, false if not.
      */
     
-    // Define our request to use for config and audio
-    RecognizeRequest c_RecognizeRequest;
+    bool GetFailed() noexcept
+    {
+        for (auto* Channel : { p_SpeechChannel.get(), p_TextToSpeechChannel.get() })
+        {
+            switch (Channel->GetState(true))
+            {
+                case GRPC_CHANNEL_TRANSIENT_FAILURE:
+                case GRPC_CHANNEL_SHUTDOWN:
+                    return true;
+                    
+                default:
+                    break;
+            }
+        }
+        
+        return false;
+    }
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    std::shared_ptr<grpc::Channel> p_SpeechChannel;
+    std::shared_ptr<grpc::Channel> p_TextToSpeechChannel;
+    
+    std::unique_ptr<Speech::Stub> p_Speech;
+    std::unique_ptr<TextToSpeech::Stub> p_TextToSpeech;
+};
+
+//*************************************************************************************
+// Call
+//*************************************************************************************
+
+class Client::Call
+{
+public:
+    
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+    
+    enum Operation
+    {
+        START = 0,
+        WRITE = 1,
+        WRITES_DONE = 2,
+        READ = 3,
+        WAKE = 4,
+        FINISH = 5,
+        
+        OPERATION_MAX = FINISH,
+        
+        OPERATION_COUNT = OPERATION_MAX + 1
+    };
+    
+    struct Tag
+    {
+        Call* p_Call;
+        Operation e_Operation;
+    };
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     *
+     *  \param e_Request The request type.
+     *  \param u32_DeadlineMS The request deadline in milliseconds, 0 for none.
+     */
+    
+    Call(Request e_Request, MRH_Uint32 u32_DeadlineMS) noexcept : e_Request(e_Request)
+    {
+        for (int i = 0; i < OPERATION_COUNT; ++i)
+        {
+            p_Tag[i].p_Call = this;
+            p_Tag[i].e_Operation = static_cast<Operation>(i);
+        }
+        
+        if (u32_DeadlineMS > 0)
+        {
+            c_Context.set_deadline(std::chrono::system_clock::now() + 
+                                   std::chrono::milliseconds(u32_DeadlineMS));
+        }
+    }
+    
+    /**
+     *  Default destructor.
+     */
     
-    // Set recognition configuration
-    auto* p_Config = c_RecognizeRequest.mutable_config();
-    p_Config->set_language_code(s_LangCode);
-    p_Config->set_sample_rate_hertz(c_Audio.GetKHz());
-    p_Config->set_encoding(RecognitionConfig::LINEAR16);
-    p_Config->set_profanity_filter(true);
-    p_Config->set_audio_channel_count(1); // Always mono
+    virtual ~Call() noexcept
+    {}
     
-    // Now add the audio
-    c_RecognizeRequest.mutable_audio()->set_content(c_Audio.GetBuffer(),
-                                                    c_Audio.GetSampleCount() * sizeof(MRH_Sint16)); // Byte len
+    //*************************************************************************************
+    // Start
+    //*************************************************************************************
     
     /**
-     *  Transcribe
+     *  Start the request.
+     *
+     *  \param p_Queue The completion queue to finish on.
      */
     
+    virtual void Start(grpc::CompletionQueue* p_Queue) = 0;
+    
+    //*************************************************************************************
+    // Proceed
+    //*************************************************************************************
+    
+    /**
+     *  Continue the request after a completion queue operation returned.
+     *
+     *  \param e_Operation The returned operation.
+     *  \param b_OK If the completion queue operation succeeded.
+     *
+     *  \return true if the request is finished, false if not.
+     */
+    
+    virtual bool Proceed(Operation e_Operation, bool b_OK) noexcept
+    {
+        if (e_Operation != FINISH)
+        {
+            return false;
+        }
+        
+        Finish(b_OK);
+        return true;
+    }
+    
+    //*************************************************************************************
+    // Finish
+    //*************************************************************************************
+    
+    /**
+     *  Finish the request and call the request callback.
+     *
+     *  \param b_OK If the completion queue operation succeeded.
+     */
+    
+    void Finish(bool b_OK) noexcept
+    {
+        bool b_Success = (b_OK == true && c_Status.ok() == true);
+        
+        if (b_Success == false)
+        {
+            if (c_Status.error_code() == grpc::StatusCode::CANCELLED)
+            {
+                Metrics::Singleton().Add(Metrics::PROVIDER_CANCELLED);
+            }
+            else
+            {
+                Metrics::Singleton().Add(Metrics::PROVIDER_FAILURE);
+                MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::ERROR, "Google Cloud API request failed: GRPC error: " +
+                                                                     c_Status.error_message(),
+                                               "GoogleCloudAPI.cpp", __LINE__);
+            }
+        }
+        
+        try
+        {
+            Perform(b_Success);
+        }
+        catch (std::exception& e)
+        {
+            MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::ERROR, e.what(),
+                                           "GoogleCloudAPI.cpp", __LINE__);
+        }
+    }
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the completion queue tag for a operation.
+     *
+     *  \param e_Operation The operation to get the tag for.
+     *
+     *  \return The operation tag.
+     */
+    
+    void* GetTag(Operation e_Operation) noexcept
+    {
+        return &(p_Tag[e_Operation]);
+    }
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    Tag p_Tag[OPERATION_COUNT];
+    Request e_Request;
+    
+    // @NOTE: Keeps the used stubs alive until finished
+    std::shared_ptr<Connection> p_Connection;
+    
     grpc::ClientContext c_Context;
-    RecognizeResponse c_RecognizeResponse;
-    grpc::Status c_RPCStatus = p_Speech->Recognize(&c_Context,
-                                                   c_RecognizeRequest,
-                                                   &c_RecognizeResponse);
+    grpc::Status c_Status;
+    
+private:
+    
+    //*************************************************************************************
+    // Perform
+    //*************************************************************************************
+    
+    /**
+     *  Read the response and call the request callback.
+     *
+     *  \param b_Success If the request succeeded.
+     */
+    
+    virtual void Perform(bool b_Success) = 0;
+    
+protected:
+    
+};
+
+class Client::TranscribeCall : public Client::Call
+{
+public:
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     *
+     *  \param c_Audio The audio to transcribe.
+     *  \param s_LangCode The language code for the transcription.
+     *  \param u32_DeadlineMS The request deadline in milliseconds, 0 for none.
+     *  \param f_Callback The result callback.
+     */
+    
+    TranscribeCall(AudioBuffer const& c_Audio, std::string const& s_LangCode, MRH_Uint32 u32_DeadlineMS, TranscribeCallback const& f_Callback) : Call(TRANSCRIBE, u32_DeadlineMS),
+                                                                                                                                                  f_Callback(f_Callback)
+    {
+        SetConfig(s_LangCode, c_Audio.GetKHz(), RecognitionConfig::LINEAR16);
+        
+        // Now add the audio
+        // @NOTE: Segments are appended directly, no contiguous copy is needed
+        std::string* p_Content = c_Request.mutable_audio()->mutable_content();
+        const MRH_Sint16* p_Segment;
+        size_t us_Elements;
+        
+        p_Content->reserve(c_Audio.GetSampleCount() * sizeof(MRH_Sint16)); // Byte len
+        
+        for (size_t i = 0; i < c_Audio.GetSegmentCount(); ++i)
+        {
+            p_Segment = c_Audio.GetSegment(i, us_Elements);
+            p_Content->append(reinterpret_cast<const char*>(p_Segment), us_Elements * sizeof(MRH_Sint16));
+        }
+    }
     
-    if (c_RPCStatus.ok() == false)
+    /**
+     *  Encoded audio constructor.
+     *
+     *  \param c_Audio The encoded audio to transcribe.
+     *  \param s_LangCode The language code for the transcription.
+     *  \param u32_DeadlineMS The request deadline in milliseconds, 0 for none.
+     *  \param f_Callback The result callback.
+     */
+    
+    TranscribeCall(AudioEncoder::Output const& c_Audio, std::string const& s_LangCode, MRH_Uint32 u32_DeadlineMS, TranscribeCallback const& f_Callback) : Call(TRANSCRIBE, u32_DeadlineMS),
+                                                                                                                                                           f_Callback(f_Callback)
     {
-        throw Exception("Failed to transcribe: GRPC streamer error: " + c_RPCStatus.error_message());
+        switch (c_Audio.e_Encoding)
+        {
+            case AudioEncoder::FLAC:
+                SetConfig(s_LangCode, c_Audio.u32_KHz, RecognitionConfig::FLAC);
+                break;
+            case AudioEncoder::OGG_OPUS:
+                SetConfig(s_LangCode, c_Audio.u32_KHz, RecognitionConfig::OGG_OPUS);
+                break;
+            default:
+                SetConfig(s_LangCode, c_Audio.u32_KHz, RecognitionConfig::LINEAR16);
+                break;
+        }
+        
+        c_Request.mutable_audio()->mutable_content()->assign(c_Audio.s_Content);
     }
     
+    //*************************************************************************************
+    // Start
+    //*************************************************************************************
+    
     /**
-     *  Select Transcribed
+     *  Start the request.
+     *
+     *  \param p_Queue The completion queue to finish on.
      */
     
-    // Check all results and grab highest confidence
-    float f32_Confidence = -1.f;
-    std::string s_Transcipt = "";
+    void Start(grpc::CompletionQueue* p_Queue) override
+    {
+        p_Reader = p_Connection->p_Speech->PrepareAsyncRecognize(&c_Context, c_Request, p_Queue);
+        p_Reader->StartCall();
+        p_Reader->Finish(&c_Response, &c_Status, GetTag(FINISH));
+    }
+    
+private:
+    
+    //*************************************************************************************
+    // Perform
+    //*************************************************************************************
+    
+    /**
+     *  Select the transcription and call the request callback.
+     *
+     *  \param b_Success If the request succeeded.
+     */
     
-    for (int i = 0; i < c_RecognizeResponse.results_size(); ++i)
+    void Perform(bool b_Success) override
     {
-        const auto& c_Result = c_RecognizeResponse.results(i);
+        if (b_Success == false)
+        {
+            f_Callback(NULL);
+            return;
+        }
         
-        for (int j = 0; j < c_Result.alternatives_size(); ++j)
+        // Check all results and grab highest confidence
+        float f32_Confidence = -1.f;
+        std::string s_Transcipt = "";
+        
+        for (int i = 0; i < c_Response.results_size(); ++i)
         {
-            const auto& c_Alternative = c_Result.alternatives(i);
+            const auto& c_Result = c_Response.results(i);
             
-            if (f32_Confidence < c_Alternative.confidence())
+            for (int j = 0; j < c_Result.alternatives_size(); ++j)
             {
-                f32_Confidence = c_Alternative.confidence();
-                s_Transcipt = c_Alternative.transcript();
+                const auto& c_Alternative = c_Result.alternatives(j);
+                
+                if (f32_Confidence < c_Alternative.confidence())
+                {
+                    f32_Confidence = c_Alternative.confidence();
+                    s_Transcipt = c_Alternative.transcript();
+                }
             }
         }
+        
+        f_Callback(&s_Transcipt);
     }
     
-    return s_Transcipt;
-}
-
-//*************************************************************************************
-// Synthesise
-//*************************************************************************************
+    //*************************************************************************************
+    // Config
+    //*************************************************************************************
+    
+    /**
+     *  Set the recognition configuration of the request.
+     *
+     *  \param s_LangCode The language code for the transcription.
+     *  \param u32_KHz The KHz of the audio.
+     *  \param e_Encoding The encoding of the audio.
+     */
+    
+    void SetConfig(std::string const& s_LangCode, MRH_Uint32 u32_KHz, RecognitionConfig::AudioEncoding e_Encoding)
+    {
+        auto* p_Config = c_Request.mutable_config();
+        p_Config->set_language_code(s_LangCode);
+        p_Config->set_sample_rate_hertz(u32_KHz);
+        p_Config->set_encoding(e_Encoding);
+        p_Config->set_profanity_filter(true);
+        p_Config->set_audio_channel_count(1); // Always mono
+    }
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    TranscribeCallback f_Callback;
+    
+    RecognizeRequest c_Request;
+    RecognizeResponse c_Response;
+    std::unique_ptr<grpc::ClientAsyncResponseReader<RecognizeResponse>> p_Reader;
+    
+protected:
+    
+};
 
-void GoogleCloudAPI::Synthesise(AudioBuffer& c_Audio, std::string const& s_String, std::string s_LangCode, MRH_Uint8 u8_VoiceGender)
+class Client::StreamTranscribeCall : public Client::Call
 {
-    if (s_String.size() == 0)
+public:
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     *
+     *  \param p_Stream The audio stream to transcribe.
+     *  \param s_LangCode The language code for the transcription.
+     *  \param u32_DeadlineMS The request deadline in milliseconds, 0 for none.
+     *  \param f_Callback The result callback.
+     */
+    
+    StreamTranscribeCall(std::shared_ptr<AudioStream> const& p_Stream, std::string const& s_LangCode, MRH_Uint32 u32_DeadlineMS, TranscribeCallback const& f_Callback) : Call(TRANSCRIBE, u32_DeadlineMS > 0 ? u32_DeadlineMS + MRH_SPEECH_GOOGLE_STREAM_LIMIT_MS : 0),
+                                                                                                                                                                        p_Stream(p_Stream),
+                                                                                                                                                                        f_Callback(f_Callback),
+                                                                                                                                                                        p_Queue(NULL),
+                                                                                                                                                                        u32_Pending(0),
+                                                                                                                                                                        b_WakePending(false),
+                                                                                                                                                                        b_Writing(false),
+                                                                                                                                                                        b_WritesDone(false),
+                                                                                                                                                                        b_InputClosed(false),
+                                                                                                                                                                        b_Finishing(false),
+                                                                                                                                                                        b_Delivered(false)
     {
-        throw Exception("Empty string given!");
+        /**
+         *  Create Request
+         */
+        
+        // @NOTE: The provider ends the stream on the end of the utterance
+        auto* p_StreamingConfig = c_Request.mutable_streaming_config();
+        p_StreamingConfig->set_single_utterance(true);
+        p_StreamingConfig->set_interim_results(false);
+        
+        // Set recognition configuration
+        auto* p_Config = p_StreamingConfig->mutable_config();
+        p_Config->set_language_code(s_LangCode);
+        p_Config->set_sample_rate_hertz(p_Stream->GetKHz());
+        p_Config->set_encoding(RecognitionConfig::LINEAR16);
+        p_Config->set_profanity_filter(true);
+        p_Config->set_audio_channel_count(1); // Always mono
     }
     
-    SsmlVoiceGender c_VoiceGender = SsmlVoiceGender::FEMALE;
+    //*************************************************************************************
+    // Start
+    //*************************************************************************************
+    
+    /**
+     *  Start the request.
+     *
+     *  \param p_Queue The completion queue to finish on.
+     */
     
-    if (u8_VoiceGender > 0)
+    void Start(grpc::CompletionQueue* p_Queue) override
     {
-        c_VoiceGender = SsmlVoiceGender::MALE;
+        this->p_Queue = p_Queue;
+        
+        p_ReaderWriter = p_Connection->p_Speech->PrepareAsyncStreamingRecognize(&c_Context, p_Queue);
+        
+        ++u32_Pending;
+        p_ReaderWriter->StartCall(GetTag(START));
     }
     
+    //*************************************************************************************
+    // Proceed
+    //*************************************************************************************
+    
     /**
-     *  Credentials Setup
+     *  Continue the request after a completion queue operation returned.
+     *
+     *  \param e_Operation The returned operation.
+     *  \param b_OK If the completion queue operation succeeded.
+     *
+     *  \return true if the request is finished, false if not.
      */
     
-    // Setup google connection with credentials for this request
-    auto c_Credentials = grpc::GoogleDefaultCredentials();
-    auto c_CloudChannel = grpc::CreateChannel("texttospeech.googleapis.com", c_Credentials);
-    std::unique_ptr<TextToSpeech::Stub> p_TextToSpeech(TextToSpeech::NewStub(c_CloudChannel));
+    bool Proceed(Operation e_Operation, bool b_OK) noexcept override
+    {
+        --u32_Pending;
+        
+        switch (e_Operation)
+        {
+            case START:
+                if (b_OK == false)
+                {
+                    StartFinish();
+                    break;
+                }
+                
+                // Configuration first, audio is written on wake up
+                ++u32_Pending;
+                b_Writing = true;
+                p_ReaderWriter->Write(c_Request, GetTag(WRITE));
+                
+                p_Stream->SetListener([this]()
+                {
+                    Wake();
+                });
+                
+                Read();
+                break;
+                
+            case WRITE:
+                b_Writing = false;
+                
+                // @NOTE: Failed writes mean a broken stream, the 
+                //        next read fails
+                if (b_OK == false)
+                {
+                    b_InputClosed = true;
+                }
+                
+                WriteNext();
+                break;
+                
+            case WAKE:
+                b_WakePending = false;
+                WriteNext();
+                break;
+                
+            case READ:
+                if (b_OK == false)
+                {
+                    StartFinish();
+                    break;
+                }
+                
+                ReadResponse();
+                Read();
+                break;
+                
+            case FINISH:
+                Finish(b_OK);
+                break;
+                
+            default:
+                break;
+        }
+        
+        return b_Finishing == true && u32_Pending == 0;
+    }
+    
+private:
+    
+    //*************************************************************************************
+    // Write
+    //*************************************************************************************
     
     /**
-     *  Create request
+     *  Wake the request from the stream writing thread. Called with the 
+     *  stream locked.
      */
     
-    // Define our request to use for config and audio
-    SynthesizeSpeechRequest c_SynthesizeRequest;
+    void Wake() noexcept
+    {
+        if (b_WakePending.exchange(true) == false)
+        {
+            ++u32_Pending;
+            c_Alarm.Set(p_Queue, gpr_now(GPR_CLOCK_MONOTONIC), GetTag(WAKE));
+        }
+    }
     
-    // Set recognition configuration
-    auto* p_AudioConfig = c_SynthesizeRequest.mutable_audio_config();
-    p_AudioConfig->set_audio_encoding(AudioEncoding::LINEAR16);
-    p_AudioConfig->set_sample_rate_hertz(c_Audio.GetKHz());
+    /**
+     *  Write the next available audio or end writing.
+     */
     
-    // Set output voice info
-    auto* p_VoiceConfig = c_SynthesizeRequest.mutable_voice();
-    p_VoiceConfig->set_ssml_gender(c_VoiceGender);
-    p_VoiceConfig->set_language_code(s_LangCode);
+    void WriteNext() noexcept
+    {
+        if (b_Writing == true || b_WritesDone == true || b_Finishing == true)
+        {
+            return;
+        }
+        
+        bool b_StreamFinished = true;
+        
+        if (b_InputClosed == false && p_Stream->Read(v_Audio, AUDIO_WRITE_SIZE_ELEMENTS, b_StreamFinished) == true)
+        {
+            c_Audio.Clear();
+            c_Audio.set_audio_content(v_Audio.data(),
+                                      v_Audio.size() * sizeof(MRH_Sint16)); // Byte len
+            
+            ++u32_Pending;
+            b_Writing = true;
+            p_ReaderWriter->Write(c_Audio, GetTag(WRITE));
+        }
+        else if (b_InputClosed == true || b_StreamFinished == true)
+        {
+            ++u32_Pending;
+            b_WritesDone = true;
+            p_ReaderWriter->WritesDone(GetTag(WRITES_DONE));
+        }
+    }
     
-    // Set the string
-    c_SynthesizeRequest.mutable_input()->set_text(s_String);
+    //*************************************************************************************
+    // Read
+    //*************************************************************************************
     
     /**
-     *  Synthesize
+     *  Read the next response.
      */
     
-    grpc::ClientContext c_Context;
-    SynthesizeSpeechResponse c_SynthesizeResponse;
-    grpc::Status c_RPCStatus = p_TextToSpeech->SynthesizeSpeech(&c_Context,
-                                                                c_SynthesizeRequest,
-                                                                &c_SynthesizeResponse);
+    void Read() noexcept
+    {
+        ++u32_Pending;
+        p_ReaderWriter->Read(&c_Response, GetTag(READ));
+    }
     
-    if (c_RPCStatus.ok() == false)
+    /**
+     *  Check a response for the final transcription.
+     */
+    
+    void ReadResponse() noexcept
     {
-        throw Exception("Failed to synthesise: GRPC streamer error: " + c_RPCStatus.error_message());
+        // Check all final results and grab highest confidence
+        float f32_Confidence = -1.f;
+        bool b_Final = false;
+        
+        for (int i = 0; i < c_Response.results_size(); ++i)
+        {
+            const auto& c_Result = c_Response.results(i);
+            
+            if (c_Result.is_final() == false)
+            {
+                continue;
+            }
+            
+            for (int j = 0; j < c_Result.alternatives_size(); ++j)
+            {
+                const auto& c_Alternative = c_Result.alternatives(j);
+                
+                if (f32_Confidence < c_Alternative.confidence())
+                {
+                    f32_Confidence = c_Alternative.confidence();
+                    s_Transcript = c_Alternative.transcript();
+                }
+            }
+            
+            b_Final = true;
+        }
+        
+        // Utterance ended, stop sending audio
+        if (b_Final == true || c_Response.speech_event_type() == StreamingRecognizeResponse::END_OF_SINGLE_UTTERANCE)
+        {
+            CloseInput();
+        }
+        
+        // Deliver now, the request finishes in the background
+        if (b_Final == true && b_Delivered == false)
+        {
+            b_Delivered = true;
+            
+            try
+            {
+                f_Callback(&s_Transcript);
+            }
+            catch (std::exception& e)
+            {
+                MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::ERROR, e.what(),
+                                               "GoogleCloudAPI.cpp", __LINE__);
+            }
+        }
     }
     
+    //*************************************************************************************
+    // Finish
+    //*************************************************************************************
+    
     /**
-     *  Add Synthesized
+     *  Stop accepting stream audio.
      */
     
-    // Grab the synth data
-    MRH_Sint16* p_Buffer = (MRH_Sint16*)c_SynthesizeResponse.audio_content().data();
-    size_t us_Elements;
+    void CloseInput() noexcept
+    {
+        if (b_InputClosed == true)
+        {
+            return;
+        }
+        
+        b_InputClosed = true;
+        p_Stream->Close();
+        
+        WriteNext();
+    }
+    
+    /**
+     *  Request the final request status.
+     */
     
-    if (p_Buffer == NULL || (us_Elements = c_SynthesizeResponse.audio_content().size() / sizeof(MRH_Sint16)) == 0)
+    void StartFinish() noexcept
     {
-        throw Exception("Invalid synthesized audio!");
+        if (b_Finishing == true)
+        {
+            return;
+        }
+        
+        // No more wake ups once the listener is removed
+        p_Stream->SetListener(std::function<void()>());
+        p_Stream->Close();
+        
+        b_Finishing = true;
+        
+        ++u32_Pending;
+        p_ReaderWriter->Finish(&c_Status, GetTag(FINISH));
+    }
+    
+    //*************************************************************************************
+    // Perform
+    //*************************************************************************************
+    
+    /**
+     *  Call the request callback if no transcription was delivered.
+     *
+     *  \param b_Success If the request succeeded.
+     */
+    
+    void Perform(bool b_Success) override
+    {
+        if (b_Delivered == true)
+        {
+            return;
+        }
+        
+        // @NOTE: Failed streams were logged on finish, finished streams 
+        //        without a final result contained no speech
+        if (b_Success == true)
+        {
+            MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::INFO, "Stream transcription contained no speech.",
+                                           "GoogleCloudAPI.cpp", __LINE__);
+        }
+        
+        f_Callback(NULL);
+    }
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    std::shared_ptr<AudioStream> p_Stream;
+    TranscribeCallback f_Callback;
+    
+    grpc::CompletionQueue* p_Queue;
+    grpc::Alarm c_Alarm;
+    std::atomic<MRH_Uint32> u32_Pending;
+    std::atomic<bool> b_WakePending;
+    
+    // @NOTE: Only used by the client thread
+    bool b_Writing;
+    bool b_WritesDone;
+    bool b_InputClosed;
+    bool b_Finishing;
+    bool b_Delivered;
+    
+    std::unique_ptr<grpc::ClientAsyncReaderWriter<StreamingRecognizeRequest, StreamingRecognizeResponse>> p_ReaderWriter;
+    StreamingRecognizeRequest c_Request;
+    StreamingRecognizeRequest c_Audio;
+    StreamingRecognizeResponse c_Response;
+    std::vector<MRH_Sint16> v_Audio;
+    std::string s_Transcript;
+    
+protected:
+    
+};
+
+class Client::SynthesiseCall : public Client::Call
+{
+public:
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     *
+     *  \param s_String The UTF-8 string to synthesise.
+     *  \param u32_KHz The KHz of the synthesized audio.
+     *  \param s_LangCode The language code for the transcription.
+     *  \param u8_VoiceGender The voice gender to use for spoken audio.
+     *  \param u32_DeadlineMS The request deadline in milliseconds, 0 for none.
+     *  \param e_Request The request type.
+     *  \param f_Callback The result callback.
+     */
+    
+    SynthesiseCall(std::string const& s_String, MRH_Uint32 u32_KHz, std::string const& s_LangCode, MRH_Uint8 u8_VoiceGender, MRH_Uint32 u32_DeadlineMS, Request e_Request, SynthesiseCallback const& f_Callback) : Call(e_Request, u32_DeadlineMS),
+                                                                                                                                                                                                                   u32_KHz(u32_KHz),
+                                                                                                                                                                                                                   f_Callback(f_Callback)
+    {
+        if (s_String.size() == 0)
+        {
+            throw Exception("Empty string given!");
+        }
+        
+        SsmlVoiceGender c_VoiceGender = SsmlVoiceGender::FEMALE;
+        
+        if (u8_VoiceGender > 0)
+        {
+            c_VoiceGender = SsmlVoiceGender::MALE;
+        }
+        
+        /**
+         *  Create request
+         */
+        
+        // Set recognition configuration
+        auto* p_AudioConfig = c_Request.mutable_audio_config();
+        p_AudioConfig->set_audio_encoding(AudioEncoding::LINEAR16);
+        p_AudioConfig->set_sample_rate_hertz(u32_KHz);
+        
+        // Set output voice info
+        auto* p_VoiceConfig = c_Request.mutable_voice();
+        p_VoiceConfig->set_ssml_gender(c_VoiceGender);
+        p_VoiceConfig->set_language_code(s_LangCode);
+        
+        // Set the string
+        c_Request.mutable_input()->set_text(s_String);
+    }
+    
+    //*************************************************************************************
+    // Start
+    //*************************************************************************************
+    
+    /**
+     *  Start the request.
+     *
+     *  \param p_Queue The completion queue to finish on.
+     */
+    
+    void Start(grpc::CompletionQueue* p_Queue) override
+    {
+        p_Reader = p_Connection->p_TextToSpeech->PrepareAsyncSynthesizeSpeech(&c_Context, c_Request, p_Queue);
+        p_Reader->StartCall();
+        p_Reader->Finish(&c_Response, &c_Status, GetTag(FINISH));
+    }
+    
+private:
+    
+    //*************************************************************************************
+    // Perform
+    //*************************************************************************************
+    
+    /**
+     *  Add the synthesized audio and call the request callback.
+     *
+     *  \param b_Success If the request succeeded.
+     */
+    
+    void Perform(bool b_Success) override
+    {
+        if (b_Success == false)
+        {
+            f_Callback(NULL);
+            return;
+        }
+        
+        // Grab the synth data
+        const MRH_Sint16* p_Buffer = (const MRH_Sint16*)c_Response.audio_content().data();
+        size_t us_Elements;
+        
+        if (p_Buffer == NULL || (us_Elements = c_Response.audio_content().size() / sizeof(MRH_Sint16)) == 0)
+        {
+            MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::ERROR, "Invalid synthesized audio!",
+                                           "GoogleCloudAPI.cpp", __LINE__);
+            f_Callback(NULL);
+            return;
+        }
+        
+        AudioBuffer c_Audio(u32_KHz, AudioPool::PLAYBACK);
+        
+        try
+        {
+            c_Audio.AddAudio(p_Buffer, us_Elements);
+        }
+        catch (Exception& e)
+        {
+            // @NOTE: The callback has to be called, requests wait for it
+            MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::ERROR, e.what(),
+                                           "GoogleCloudAPI.cpp", __LINE__);
+            f_Callback(NULL);
+            return;
+        }
+        
+        f_Callback(&c_Audio);
+    }
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    MRH_Uint32 u32_KHz;
+    SynthesiseCallback f_Callback;
+    
+    SynthesizeSpeechRequest c_Request;
+    SynthesizeSpeechResponse c_Response;
+    std::unique_ptr<grpc::ClientAsyncResponseReader<SynthesizeSpeechResponse>> p_Reader;
+    
+protected:
+    
+};
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+Client::Client(Configuration const& c_Configuration) : p_Queue(new grpc::CompletionQueue()),
+                                                       b_Shutdown(false),
+                                                       u32_KeepaliveMS(c_Configuration.GetGoogleKeepaliveMS()),
+                                                       u32_CredentialRefreshS(c_Configuration.GetGoogleCredentialRefreshS())
+{
+    // @NOTE: Idle pings below the minimum interval are answered with 
+    //        a GOAWAY (too_many_pings), which closes the connection
+    if (u32_KeepaliveMS > 0 && u32_KeepaliveMS < MRH_SPEECH_GOOGLE_KEEPALIVE_MIN_MS)
+    {
+        MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::WARNING, "Keepalive interval below " +
+                                                               std::to_string(MRH_SPEECH_GOOGLE_KEEPALIVE_MIN_MS) +
+                                                               " ms, using the minimum.",
+                                       "GoogleCloudAPI.cpp", __LINE__);
+        
+        u32_KeepaliveMS = MRH_SPEECH_GOOGLE_KEEPALIVE_MIN_MS;
+    }
+    
+    // Create the first connection now, the connection is warmed up by 
+    // the maintenance thread
+    try
+    {
+        p_Connection = std::make_shared<Connection>(u32_KeepaliveMS);
+    }
+    catch (std::exception& e)
+    {
+        // @NOTE: No crashing, the maintenance thread retries
+        MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::ERROR, "Failed to connect to Google Cloud API: " +
+                                                             std::string(e.what()),
+                                       "GoogleCloudAPI.cpp", __LINE__);
     }
     
     try
     {
-        c_Audio.AddAudio(p_Buffer, us_Elements);
+        c_Thread = std::thread(Update, this);
+        c_MaintainThread = std::thread(Maintain, this);
+    }
+    catch (std::exception& e)
+    {
+        if (c_Thread.joinable() == true)
+        {
+            p_Queue->Shutdown();
+            c_Thread.join();
+        }
+        
+        throw Exception("Failed to start Google Cloud API client thread: " + std::string(e.what()));
+    }
+}
+
+Client::~Client() noexcept
+{
+    // Cancel all remaining, no new requests afterwards
+    {
+        std::lock_guard<std::mutex> c_Guard(c_Mutex);
+        
+        for (auto& Call : l_Call)
+        {
+            Call->c_Context.TryCancel();
+        }
+        
+        b_Shutdown = true;
+    }
+    
+    c_Condition.notify_all();
+    c_MaintainThread.join();
+    
+    // Wait for cancelled requests, streams might still add operations
+    {
+        std::unique_lock<std::mutex> c_Lock(c_Mutex);
+        
+        c_Condition.wait(c_Lock, [this]()
+        {
+            return l_Call.size() == 0;
+        });
+    }
+    
+    // @NOTE: The queue returns all remaining requests before
+    //        stopping the client thread
+    p_Queue->Shutdown();
+    c_Thread.join();
+}
+
+//*************************************************************************************
+// Update
+//*************************************************************************************
+
+void Client::Update(Client* p_Instance) noexcept
+{
+    void* p_Tag;
+    bool b_OK;
+    
+    while (p_Instance->p_Queue->Next(&p_Tag, &b_OK) == true)
+    {
+        Call::Tag* p_CallTag = static_cast<Call::Tag*>(p_Tag);
+        Call* p_Call = p_CallTag->p_Call;
+        
+        // @NOTE: Callbacks might start new requests, never hold the lock
+        if (p_Call->Proceed(p_CallTag->e_Operation, b_OK) == false)
+        {
+            continue;
+        }
+        
+        {
+            std::lock_guard<std::mutex> c_Guard(p_Instance->c_Mutex);
+            p_Instance->l_Call.remove(p_Call);
+        }
+        
+        delete p_Call;
+        p_Instance->c_Condition.notify_all();
+    }
+}
+
+void Client::Maintain(Client* p_Instance) noexcept
+{
+    MRH_PSBLogger& c_Logger = MRH_PSBLogger::Singleton();
+    
+    MRH_Uint32 u32_KeepaliveMS = p_Instance->u32_KeepaliveMS;
+    MRH_Uint32 u32_CredentialRefreshS = p_Instance->u32_CredentialRefreshS;
+    MRH_Uint64 u64_RefreshTimePointS = time(NULL) + u32_CredentialRefreshS;
+    
+    std::shared_ptr<Connection> p_Current;
+    MRH_Uint32 u32_WaitMS = 0;
+    bool b_Warm = false;
+    
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> c_Lock(p_Instance->c_Mutex);
+            
+            p_Instance->c_Condition.wait_for(c_Lock, std::chrono::milliseconds(u32_WaitMS), [p_Instance]()
+            {
+                return p_Instance->b_Shutdown;
+            });
+            
+            if (p_Instance->b_Shutdown == true)
+            {
+                return;
+            }
+            
+            p_Current = p_Instance->p_Connection;
+        }
+        
+        u32_WaitMS = MRH_SPEECH_GOOGLE_CONNECTION_CHECK_MS;
+        
+        // Warm up the first connection before the first request
+        if (p_Current && b_Warm == false)
+        {
+            if (p_Current->WaitForConnected(MRH_SPEECH_GOOGLE_CONNECTION_WARM_UP_MS) == true)
+            {
+                c_Logger.Log(MRH_PSBLogger::INFO, "Connected to Google Cloud API.",
+                             "GoogleCloudAPI.cpp", __LINE__);
+            }
+            
+            b_Warm = true;
+            continue;
+        }
+        
+        // Replace failed or outdated connections
+        bool b_Refresh = (u32_CredentialRefreshS > 0 && u64_RefreshTimePointS <= static_cast<MRH_Uint64>(time(NULL)));
+        
+        if (p_Current && p_Current->GetFailed() == false && b_Refresh == false)
+        {
+            continue;
+        }
+        
+        // @NOTE: Credentials are read again, the new connection is 
+        //        only used once connected
+        std::shared_ptr<Connection> p_Connection;
+        
+        try
+        {
+            p_Connection = std::make_shared<Connection>(u32_KeepaliveMS);
+        }
+        catch (std::exception& e)
+        {
+            c_Logger.Log(MRH_PSBLogger::ERROR, "Failed to connect to Google Cloud API: " +
+                                               std::string(e.what()),
+                         "GoogleCloudAPI.cpp", __LINE__);
+            
+            u32_WaitMS = MRH_SPEECH_GOOGLE_CONNECTION_RETRY_MS;
+            continue;
+        }
+        
+        if (p_Connection->WaitForConnected(MRH_SPEECH_GOOGLE_CONNECTION_WARM_UP_MS) == false && p_Current)
+        {
+            // Keep the current connection, grpc keeps retrying it
+            u32_WaitMS = MRH_SPEECH_GOOGLE_CONNECTION_RETRY_MS;
+            continue;
+        }
+        
+        u64_RefreshTimePointS = time(NULL) + u32_CredentialRefreshS;
+        
+        if (b_Refresh == false)
+        {
+            Metrics::Singleton().Add(Metrics::PROVIDER_RECONNECT);
+            c_Logger.Log(MRH_PSBLogger::WARNING, "Reconnected to Google Cloud API.",
+                         "GoogleCloudAPI.cpp", __LINE__);
+        }
+        
+        // Active requests keep their connection
+        std::lock_guard<std::mutex> c_Guard(p_Instance->c_Mutex);
+        p_Instance->p_Connection = p_Connection;
+    }
+}
+
+//*************************************************************************************
+// Start
+//*************************************************************************************
+
+void Client::Add(Call* p_Call)
+{
+    std::unique_ptr<Call> p_Owned(p_Call);
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+    
+    if (b_Shutdown == true)
+    {
+        throw Exception("Google Cloud API client is shut down!");
+    }
+    else if (!p_Connection)
+    {
+        throw Exception("Not connected to Google Cloud API!");
+    }
+    
+    p_Call->p_Connection = p_Connection;
+    l_Call.push_back(p_Call);
+    
+    try
+    {
+        p_Call->Start(p_Queue.get());
     }
     catch (...)
+    {
+        l_Call.pop_back();
+        throw;
+    }
+    
+    // Started, now owned by the queue
+    p_Owned.release();
+    
+    Metrics::Singleton().Add(Metrics::PROVIDER_REQUEST);
+}
+
+//*************************************************************************************
+// Transcribe
+//*************************************************************************************
+
+void Client::Transcribe(AudioBuffer const& c_Audio, std::string const& s_LangCode, MRH_Uint32 u32_DeadlineMS, TranscribeCallback const& f_Callback)
+{
+    // Audio available?
+    if (c_Audio.GetSampleCount() == 0)
+    {
+        throw Exception("No audio to transcribe added!");
+    }
+    
+    try
+    {
+        Add(new TranscribeCall(c_Audio, s_LangCode, u32_DeadlineMS, f_Callback));
+    }
+    catch (Exception& e)
+    {
+        throw;
+    }
+    catch (std::exception& e)
+    {
+        throw Exception("Failed to transcribe: " + std::string(e.what()));
+    }
+}
+
+void Client::Transcribe(AudioEncoder::Output const& c_Audio, std::string const& s_LangCode, MRH_Uint32 u32_DeadlineMS, TranscribeCallback const& f_Callback)
+{
+    // Audio available?
+    if (c_Audio.s_Content.size() == 0)
+    {
+        throw Exception("No audio to transcribe added!");
+    }
+    
+    try
+    {
+        Add(new TranscribeCall(c_Audio, s_LangCode, u32_DeadlineMS, f_Callback));
+    }
+    catch (Exception& e)
+    {
+        throw;
+    }
+    catch (std::exception& e)
+    {
+        throw Exception("Failed to transcribe: " + std::string(e.what()));
+    }
+}
+
+void Client::StreamTranscribe(std::shared_ptr<AudioStream> const& p_Stream, std::string const& s_LangCode, MRH_Uint32 u32_DeadlineMS, TranscribeCallback const& f_Callback)
+{
+    try
+    {
+        Add(new StreamTranscribeCall(p_Stream, s_LangCode, u32_DeadlineMS, f_Callback));
+    }
+    catch (Exception& e)
     {
         throw;
     }
+    catch (std::exception& e)
+    {
+        throw Exception("Failed to transcribe: " + std::string(e.what()));
+    }
+}
+
+//*************************************************************************************
+// Synthesise
+//*************************************************************************************
+
+void Client::Synthesise(std::string const& s_String, MRH_Uint32 u32_KHz, std::string const& s_LangCode, MRH_Uint8 u8_VoiceGender, MRH_Uint32 u32_DeadlineMS, Request e_Request, SynthesiseCallback const& f_Callback)
+{
+    if (e_Request != SYNTHESISE && e_Request != PRESYNTHESISE)
+    {
+        throw Exception("Invalid synthesise request type!");
+    }
+    
+    try
+    {
+        Add(new SynthesiseCall(s_String, u32_KHz, s_LangCode, u8_VoiceGender, u32_DeadlineMS, e_Request, f_Callback));
+    }
+    catch (Exception& e)
+    {
+        throw;
+    }
+    catch (std::exception& e)
+    {
+        throw Exception("Failed to synthesise: " + std::string(e.what()));
+    }
+}
+
+//*************************************************************************************
+// Cancel
+//*************************************************************************************
+
+void Client::Cancel(Request e_Request) noexcept
+{
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+    
+    for (auto& Call : l_Call)
+    {
+        if (Call->e_Request == e_Request)
+        {
+            Call->c_Context.TryCancel();
+        }
+    }
 }
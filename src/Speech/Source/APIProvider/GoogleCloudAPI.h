@@ -19,44 +19,218 @@
 
 // C / C++
 #include <string>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <list>
 
 // External
 
 // Project
 #include "../Audio/AudioBuffer.h"
+#include "../Audio/AudioEncoder.h"
+#include "../Audio/AudioStream.h"
+#include "../../../Configuration.h"
+
+namespace grpc
+{
+    class CompletionQueue;
+}
 
 
 namespace GoogleCloudAPI
 {
     //*************************************************************************************
-    // Transcribe
+    // Types
     //*************************************************************************************
     
+    enum Request
+    {
+        TRANSCRIBE = 0,
+        SYNTHESISE = 1,
+        PRESYNTHESISE = 2, // Synthesise, cancelled separately
+        
+        REQUEST_MAX = PRESYNTHESISE,
+        
+        REQUEST_COUNT = REQUEST_MAX + 1
+    };
+    
     /**
-     *  Transcribe audio to a string.
-     *
-     *  \param c_Audio The audio to transcribe.
-     *  \param s_LangCode The language code for the transcription.
-     *
-     *  \return The transcription result string.
+     *  Called with the transcription result string, NULL if the request failed.
      */
     
-    std::string Transcribe(AudioBuffer const& c_Audio, std::string s_LangCode);
-    
-    //*************************************************************************************
-    // Synthesise
-    //*************************************************************************************
+    typedef std::function<void(std::string* p_Transcript)> TranscribeCallback;
     
     /**
-     *  Synthesise a string to audio.
-     *
-     *  \param c_Audio The audio buffer to store the synthesized audio in.
-     *  \param s_String The UTF-8 string to synthesise.
-     *  \param s_LangCode The language code for the transcription.
-     *  \param u8_VoiceGender The voice gender to use for spoken audio.
+     *  Called with the synthesized audio, NULL if the request failed.
      */
     
-    void Synthesise(AudioBuffer& c_Audio, std::string const& s_String, std::string s_LangCode, MRH_Uint8 u8_VoiceGender);
+    typedef std::function<void(AudioBuffer* p_Audio)> SynthesiseCallback;
+    
+    //*************************************************************************************
+    // Client
+    //*************************************************************************************
+    
+    class Client
+    {
+    public:
+        
+        //*************************************************************************************
+        // Constructor / Destructor
+        //*************************************************************************************
+        
+        /**
+         *  Default constructor.
+         *
+         *  \param c_Configuration The configuration to construct with.
+         */
+        
+        Client(Configuration const& c_Configuration);
+        
+        /**
+         *  Default destructor.
+         */
+        
+        ~Client() noexcept;
+        
+        //*************************************************************************************
+        // Transcribe
+        //*************************************************************************************
+        
+        /**
+         *  Start transcribing audio to a string. This function is thread safe.
+         *
+         *  \param c_Audio The audio to transcribe.
+         *  \param s_LangCode The language code for the transcription.
+         *  \param u32_DeadlineMS The request deadline in milliseconds, 0 for none.
+         *  \param f_Callback The callback called on the client thread once finished.
+         */
+        
+        void Transcribe(AudioBuffer const& c_Audio, std::string const& s_LangCode, MRH_Uint32 u32_DeadlineMS, TranscribeCallback const& f_Callback);
+        
+        /**
+         *  Start transcribing encoded audio to a string. This function is thread safe.
+         *
+         *  \param c_Audio The encoded audio to transcribe.
+         *  \param s_LangCode The language code for the transcription.
+         *  \param u32_DeadlineMS The request deadline in milliseconds, 0 for none.
+         *  \param f_Callback The callback called on the client thread once finished.
+         */
+        
+        void Transcribe(AudioEncoder::Output const& c_Audio, std::string const& s_LangCode, MRH_Uint32 u32_DeadlineMS, TranscribeCallback const& f_Callback);
+        
+        /**
+         *  Start transcribing streamed audio to a string. Audio is sent while 
+         *  it is written to the stream, the stream is closed once the provider 
+         *  detected the end of the utterance. This function is thread safe.
+         *
+         *  \param p_Stream The audio stream to transcribe.
+         *  \param s_LangCode The language code for the transcription.
+         *  \param u32_DeadlineMS The request deadline in milliseconds after the 
+         *                        stream limit, 0 for none.
+         *  \param f_Callback The callback called on the client thread once the 
+         *                    final transcription was recieved.
+         */
+        
+        void StreamTranscribe(std::shared_ptr<AudioStream> const& p_Stream, std::string const& s_LangCode, MRH_Uint32 u32_DeadlineMS, TranscribeCallback const& f_Callback);
+        
+        //*************************************************************************************
+        // Synthesise
+        //*************************************************************************************
+        
+        /**
+         *  Start synthesising a string to audio. This function is thread safe.
+         *
+         *  \param s_String The UTF-8 string to synthesise.
+         *  \param u32_KHz The KHz of the synthesized audio.
+         *  \param s_LangCode The language code for the transcription.
+         *  \param u8_VoiceGender The voice gender to use for spoken audio.
+         *  \param u32_DeadlineMS The request deadline in milliseconds, 0 for none.
+         *  \param e_Request The request type, SYNTHESISE or PRESYNTHESISE.
+         *  \param f_Callback The callback called on the client thread once finished.
+         */
+        
+        void Synthesise(std::string const& s_String, MRH_Uint32 u32_KHz, std::string const& s_LangCode, MRH_Uint8 u8_VoiceGender, MRH_Uint32 u32_DeadlineMS, Request e_Request, SynthesiseCallback const& f_Callback);
+        
+        //*************************************************************************************
+        // Cancel
+        //*************************************************************************************
+        
+        /**
+         *  Cancel all active requests of a type. Callbacks of cancelled requests 
+         *  are still called. This function is thread safe.
+         *
+         *  \param e_Request The request type to cancel.
+         */
+        
+        void Cancel(Request e_Request) noexcept;
+        
+    private:
+        
+        //*************************************************************************************
+        // Types
+        //*************************************************************************************
+        
+        class Connection;
+        class Call;
+        class TranscribeCall;
+        class StreamTranscribeCall;
+        class SynthesiseCall;
+        
+        //*************************************************************************************
+        // Update
+        //*************************************************************************************
+        
+        /**
+         *  Finish completed requests.
+         *
+         *  \param p_Instance The client instance to update.
+         */
+        
+        static void Update(Client* p_Instance) noexcept;
+        
+        /**
+         *  Warm up, check and refresh the provider connection.
+         *
+         *  \param p_Instance The client instance to maintain.
+         */
+        
+        static void Maintain(Client* p_Instance) noexcept;
+        
+        //*************************************************************************************
+        // Start
+        //*************************************************************************************
+        
+        /**
+         *  Add a request to the active requests.
+         *
+         *  \param p_Call The request to add.
+         */
+        
+        void Add(Call* p_Call);
+        
+        //*************************************************************************************
+        // Data
+        //*************************************************************************************
+        
+        std::unique_ptr<grpc::CompletionQueue> p_Queue;
+        std::thread c_Thread;
+        std::thread c_MaintainThread;
+        
+        std::mutex c_Mutex;
+        std::condition_variable c_Condition;
+        std::list<Call*> l_Call;
+        std::shared_ptr<Connection> p_Connection;
+        bool b_Shutdown;
+        
+        MRH_Uint32 u32_KeepaliveMS;
+        MRH_Uint32 u32_CredentialRefreshS;
+        
+    protected:
+        
+    };
 };
 
 #endif /* GoogleCloudAPI_h */
@@ -27,12 +27,45 @@
 // Constructor / Destructor
 //*************************************************************************************
 
-AudioBuffer::AudioBuffer(MRH_Uint32 u32_KHz) noexcept : us_SampleCount(0),
-                                                        u32_KHz(u32_KHz)
+AudioBuffer::AudioBuffer(MRH_Uint32 u32_KHz, AudioPool::Use e_Use) noexcept : us_SampleCount(0),
+                                                                              u32_KHz(u32_KHz),
+                                                                              e_Use(e_Use)
 {}
 
+AudioBuffer::AudioBuffer(AudioBuffer&& c_Buffer) noexcept : v_Block(std::move(c_Buffer.v_Block)),
+                                                            us_SampleCount(c_Buffer.us_SampleCount),
+                                                            v_Contiguous(std::move(c_Buffer.v_Contiguous)),
+                                                            u32_KHz(c_Buffer.u32_KHz),
+                                                            e_Use(c_Buffer.e_Use)
+{
+    c_Buffer.v_Block.clear();
+    c_Buffer.us_SampleCount = 0;
+}
+
 AudioBuffer::~AudioBuffer() noexcept
-{}
+{
+    Clear(u32_KHz);
+}
+
+//*************************************************************************************
+// Operator
+//*************************************************************************************
+
+AudioBuffer& AudioBuffer::operator=(AudioBuffer&& c_Buffer) noexcept
+{
+    if (this != &c_Buffer)
+    {
+        Clear(c_Buffer.u32_KHz);
+        
+        v_Block.swap(c_Buffer.v_Block);
+        v_Contiguous.swap(c_Buffer.v_Contiguous);
+        us_SampleCount = c_Buffer.us_SampleCount;
+        
+        c_Buffer.us_SampleCount = 0;
+    }
+    
+    return *this;
+}
 
 //*************************************************************************************
 // Clear
@@ -40,7 +73,16 @@ AudioBuffer::~AudioBuffer() noexcept
 
 void AudioBuffer::Clear(MRH_Uint32 u32_KHz) noexcept
 {
-    // Set the count, no vector modify
+    // Blocks go back to the pool, the block list keeps its capacity
+    AudioPool& c_Pool = AudioPool::Singleton();
+    
+    for (auto& Block : v_Block)
+    {
+        c_Pool.Release(Block);
+    }
+    
+    v_Block.clear();
+    v_Contiguous.clear();
     us_SampleCount = 0;
     
     // Update KHz
@@ -53,32 +95,60 @@ void AudioBuffer::Clear(MRH_Uint32 u32_KHz) noexcept
 
 void AudioBuffer::AddAudio(const MRH_Sint16* p_Buffer, size_t us_Elements)
 {
-    if (v_Samples.size() < (us_SampleCount + us_Elements))
+    size_t us_Offset = us_SampleCount % MRH_SPEECH_AUDIO_POOL_BLOCK_SIZE;
+    size_t us_Copy;
+    
+    // @NOTE: The contiguous copy no longer matches
+    v_Contiguous.clear();
+    
+    while (us_Elements > 0)
     {
-        try
+        // Last block full, append a new one
+        if (us_Offset == 0 && v_Block.size() * MRH_SPEECH_AUDIO_POOL_BLOCK_SIZE == us_SampleCount)
         {
-            v_Samples.insert(v_Samples.end(),
-                             (us_SampleCount + us_Elements) - v_Samples.size(),
-                             0);
+            try
+            {
+                // @NOTE: Grow first, a acquired block is never lost
+                if (v_Block.size() == v_Block.capacity())
+                {
+                    v_Block.reserve(v_Block.capacity() > 0 ? v_Block.capacity() * 2 : 16);
+                }
+                
+                v_Block.push_back(AudioPool::Singleton().Acquire(e_Use));
+            }
+            catch (Exception& e)
+            {
+                throw;
+            }
+            catch (std::exception& e)
+            {
+                throw Exception("Failed to add audio block: " + std::string(e.what()));
+            }
         }
-        catch (...)
+        
+        us_Copy = MRH_SPEECH_AUDIO_POOL_BLOCK_SIZE - us_Offset;
+        
+        if (us_Copy > us_Elements)
         {
-            throw;
+            us_Copy = us_Elements;
         }
+        
+        std::memcpy(&(v_Block.back()->p_Samples[us_Offset]),
+                    p_Buffer,
+                    us_Copy * sizeof(MRH_Sint16));
+        
+        p_Buffer += us_Copy;
+        us_Elements -= us_Copy;
+        us_SampleCount += us_Copy;
+        us_Offset = 0;
     }
-    
-    std::memcpy(&(v_Samples[us_SampleCount]),
-                p_Buffer,
-                us_Elements * sizeof(MRH_Sint16));
-    
-    us_SampleCount += us_Elements;
 }
 
 void AudioBuffer::AddAudio(std::vector<MRH_Sint16> const& v_Buffer)
 {
     try
     {
-        AddAudio(&(v_Buffer[0]), v_Buffer.size());
+        AddAudio(v_Buffer.data(), v_Buffer.size());
     }
     catch (...)
     {
@@ -86,13 +156,94 @@ void AudioBuffer::AddAudio(std::vector<MRH_Sint16> const& v_Buffer)
     }
 }
 
+void AudioBuffer::AddAudio(AudioBuffer const& c_Buffer, size_t us_Offset, size_t us_Elements)
+{
+    if ((us_Offset + us_Elements) > c_Buffer.us_SampleCount)
+    {
+        throw Exception("Audio range exceeds the audio buffer!");
+    }
+    
+    // Copy from all segments in range
+    size_t us_Segment = us_Offset / MRH_SPEECH_AUDIO_POOL_BLOCK_SIZE;
+    size_t us_SegmentOffset = us_Offset % MRH_SPEECH_AUDIO_POOL_BLOCK_SIZE;
+    const MRH_Sint16* p_Segment;
+    size_t us_Available;
+    
+    while (us_Elements > 0)
+    {
+        p_Segment = c_Buffer.GetSegment(us_Segment, us_Available);
+        us_Available -= us_SegmentOffset;
+        
+        if (us_Available > us_Elements)
+        {
+            us_Available = us_Elements;
+        }
+        
+        AddAudio(p_Segment + us_SegmentOffset, us_Available);
+        
+        us_Elements -= us_Available;
+        us_SegmentOffset = 0;
+        ++us_Segment;
+    }
+}
+
 //*************************************************************************************
 // Getters
 //*************************************************************************************
 
-const MRH_Sint16* AudioBuffer::GetBuffer() const noexcept
+const MRH_Sint16* AudioBuffer::GetBuffer()
+{
+    if (us_SampleCount == 0)
+    {
+        return NULL;
+    }
+    else if (v_Block.size() == 1)
+    {
+        return v_Block[0]->p_Samples;
+    }
+    else if (v_Contiguous.size() != us_SampleCount)
+    {
+        try
+        {
+            v_Contiguous.resize(us_SampleCount);
+        }
+        catch (std::exception& e)
+        {
+            throw Exception("Failed to create contiguous audio: " + std::string(e.what()));
+        }
+        
+        MRH_Sint16* p_Contiguous = v_Contiguous.data();
+        const MRH_Sint16* p_Segment;
+        size_t us_Elements;
+        
+        for (size_t i = 0; i < v_Block.size(); ++i)
+        {
+            p_Segment = GetSegment(i, us_Elements);
+            std::memcpy(p_Contiguous, p_Segment, us_Elements * sizeof(MRH_Sint16));
+            p_Contiguous += us_Elements;
+        }
+    }
+    
+    return v_Contiguous.data();
+}
+
+size_t AudioBuffer::GetSegmentCount() const noexcept
 {
-    return &(v_Samples[0]);
+    return v_Block.size();
+}
+
+const MRH_Sint16* AudioBuffer::GetSegment(size_t us_Segment, size_t& us_Elements) const noexcept
+{
+    if ((us_Segment + 1) < v_Block.size())
+    {
+        us_Elements = MRH_SPEECH_AUDIO_POOL_BLOCK_SIZE;
+    }
+    else
+    {
+        us_Elements = us_SampleCount - (us_Segment * MRH_SPEECH_AUDIO_POOL_BLOCK_SIZE);
+    }
+    
+    return v_Block[us_Segment]->p_Samples;
 }
 
 size_t AudioBuffer::GetSampleCount() const noexcept
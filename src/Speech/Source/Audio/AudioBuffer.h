@@ -24,6 +24,7 @@
 #include <MRH_Typedefs.h>
 
 // Project
+#include "./AudioPool.h"
 #include "../../../Exception.h"
 
 
@@ -39,22 +40,45 @@ public:
      *  Default constructor.
      *
      *  \param u32_KHz The audio buffer KHz.
+     *  \param e_Use The audio pool use for added audio.
      */
     
-    AudioBuffer(MRH_Uint32 u32_KHz) noexcept;
+    AudioBuffer(MRH_Uint32 u32_KHz, AudioPool::Use e_Use) noexcept;
     
     /**
-     *  Default destructor.
+     *  Move constructor.
+     *
+     *  \param c_Buffer The audio buffer to take the audio from.
+     */
+    
+    AudioBuffer(AudioBuffer&& c_Buffer) noexcept;
+    
+    /**
+     *  Default destructor. All audio blocks are returned to the pool.
      */
     
     ~AudioBuffer() noexcept;
     
+    //*************************************************************************************
+    // Operator
+    //*************************************************************************************
+    
+    /**
+     *  Move assignment. The current audio blocks are returned to the pool.
+     *
+     *  \param c_Buffer The audio buffer to take the audio from.
+     *
+     *  \return The audio buffer.
+     */
+    
+    AudioBuffer& operator=(AudioBuffer&& c_Buffer) noexcept;
+    
     //*************************************************************************************
     // Clear
     //*************************************************************************************
     
     /**
-     *  Clear all audio chunks.
+     *  Clear all audio chunks. All audio blocks are returned to the pool.
      *
      *  \param u32_KHz The KHz stored in the audio buffer.
      */
@@ -82,17 +106,48 @@ public:
     
     void AddAudio(std::vector<MRH_Sint16> const& v_Buffer);
     
+    /**
+     *  Add audio stored in another audio buffer to the track.
+     *
+     *  \param c_Buffer The audio buffer to add from.
+     *  \param us_Offset The sample offset in the audio buffer.
+     *  \param us_Elements The amount of samples to add.
+     */
+    
+    void AddAudio(AudioBuffer const& c_Buffer, size_t us_Offset, size_t us_Elements);
+    
     //*************************************************************************************
     // Getters
     //*************************************************************************************
     
     /**
-     *  Get the audio buffer.
+     *  Get the audio as a single contiguous buffer. Audio stored in multiple 
+     *  segments is copied once into a contiguous buffer kept until the audio 
+     *  changes.
      *
-     *  \return The audio buffer.
+     *  \return The audio buffer, NULL if empty.
+     */
+    
+    const MRH_Sint16* GetBuffer();
+    
+    /**
+     *  Get the amount of stored audio segments.
+     *
+     *  \return The audio segment count.
+     */
+    
+    size_t GetSegmentCount() const noexcept;
+    
+    /**
+     *  Get a stored audio segment.
+     *
+     *  \param us_Segment The audio segment to get.
+     *  \param us_Elements The elements in the audio segment.
+     *
+     *  \return The audio segment.
      */
     
-    const MRH_Sint16* GetBuffer() const noexcept;
+    const MRH_Sint16* GetSegment(size_t us_Segment, size_t& us_Elements) const noexcept;
     
     /**
      *  Get the amount of samples currently stored.
@@ -116,10 +171,14 @@ private:
     // Data
     //*************************************************************************************
     
-    std::vector<MRH_Sint16> v_Samples;
-    size_t us_SampleCount; // Buffer doesn't shrink, this defines samples
+    // @NOTE: All blocks except the last one are full
+    std::vector<AudioPool::Block*> v_Block;
+    size_t us_SampleCount;
+    
+    std::vector<MRH_Sint16> v_Contiguous; // Only filled on request
     
     MRH_Uint32 u32_KHz;
+    AudioPool::Use e_Use;
     
 protected:
     
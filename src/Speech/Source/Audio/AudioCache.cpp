@@ -0,0 +1,166 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+// C / C++
+
+// External
+#include <libmrhpsb/MRH_PSBLogger.h>
+
+// Project
+#include "./AudioCache.h"
+#include "../../../Metrics.h"
+
+
+namespace
+{
+    //*************************************************************************************
+    // Size
+    //*************************************************************************************
+    
+    inline size_t GetEntryBytes(std::string const& s_Key, size_t us_Samples) noexcept
+    {
+        return s_Key.size() + (us_Samples * sizeof(MRH_Sint16));
+    }
+}
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+AudioCache::AudioCache(size_t us_MaxBytes) noexcept : us_Bytes(0),
+                                                      us_MaxBytes(us_MaxBytes)
+{}
+
+AudioCache::~AudioCache() noexcept
+{}
+
+//*************************************************************************************
+// Add
+//*************************************************************************************
+
+void AudioCache::Add(std::string const& s_Key, AudioBuffer const& c_Audio, MRH_Uint64 u64_LatencyMS) noexcept
+{
+    size_t us_EntryBytes = GetEntryBytes(s_Key, c_Audio.GetSampleCount());
+    
+    if (us_EntryBytes > us_MaxBytes || c_Audio.GetSampleCount() == 0)
+    {
+        return;
+    }
+    
+    try
+    {
+        // Copy outside of the lock, the cache is read by multiple threads
+        std::shared_ptr<std::vector<MRH_Sint16>> p_Samples = std::make_shared<std::vector<MRH_Sint16>>();
+        const MRH_Sint16* p_Segment;
+        size_t us_Elements;
+        
+        p_Samples->reserve(c_Audio.GetSampleCount());
+        
+        for (size_t i = 0; i < c_Audio.GetSegmentCount(); ++i)
+        {
+            p_Segment = c_Audio.GetSegment(i, us_Elements);
+            p_Samples->insert(p_Samples->end(), p_Segment, p_Segment + us_Elements);
+        }
+        
+        std::lock_guard<std::mutex> c_Guard(c_Mutex);
+        
+        // Added by a parallel request?
+        if (m_Entry.find(s_Key) != m_Entry.end())
+        {
+            return;
+        }
+        
+        // Remove least recently used until the audio fits
+        while (us_Bytes + us_EntryBytes > us_MaxBytes)
+        {
+            Entry& c_Last = l_Entry.back();
+            
+            us_Bytes -= GetEntryBytes(c_Last.s_Key, c_Last.p_Samples->size());
+            m_Entry.erase(c_Last.s_Key);
+            l_Entry.pop_back();
+            
+            Metrics::Singleton().Add(Metrics::SYNTHESIS_CACHE_EVICTED);
+        }
+        
+        l_Entry.push_front({ s_Key, c_Audio.GetKHz(), u64_LatencyMS, p_Samples });
+        
+        try
+        {
+            m_Entry.emplace(s_Key, l_Entry.begin());
+        }
+        catch (...)
+        {
+            l_Entry.pop_front();
+            throw;
+        }
+        
+        us_Bytes += us_EntryBytes;
+    }
+    catch (std::exception& e)
+    {
+        // @NOTE: Caching is optional, the audio is still played
+        MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::WARNING, "Failed to cache audio: " + std::string(e.what()),
+                                       "AudioCache.cpp", __LINE__);
+    }
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+bool AudioCache::GetAudio(std::string const& s_Key, AudioBuffer& c_Audio)
+{
+    Metrics& c_Metrics = Metrics::Singleton();
+    std::shared_ptr<const std::vector<MRH_Sint16>> p_Samples;
+    MRH_Uint32 u32_KHz;
+    
+    {
+        std::lock_guard<std::mutex> c_Guard(c_Mutex);
+        
+        auto Entry = m_Entry.find(s_Key);
+        
+        if (Entry == m_Entry.end())
+        {
+            c_Metrics.Add(Metrics::SYNTHESIS_CACHE_MISS);
+            return false;
+        }
+        
+        // Now most recently used
+        l_Entry.splice(l_Entry.begin(), l_Entry, Entry->second);
+        
+        p_Samples = Entry->second->p_Samples;
+        u32_KHz = Entry->second->u32_KHz;
+        
+        c_Metrics.Add(Metrics::SYNTHESIS_CACHE_HIT);
+        c_Metrics.Add(Metrics::SYNTHESIS_CACHE_SAVED_MS, Entry->second->u64_LatencyMS);
+    }
+    
+    c_Audio.Clear(u32_KHz);
+    c_Audio.AddAudio(p_Samples->data(), p_Samples->size());
+    
+    return true;
+}
+
+bool AudioCache::GetCached(std::string const& s_Key) noexcept
+{
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+    return m_Entry.find(s_Key) != m_Entry.end();
+}
+
+bool AudioCache::GetEnabled() const noexcept
+{
+    return us_MaxBytes > 0;
+}
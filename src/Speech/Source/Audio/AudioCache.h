@@ -0,0 +1,134 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#ifndef AudioCache_h
+#define AudioCache_h
+
+// C / C++
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+
+// External
+#include <MRH_Typedefs.h>
+
+// Project
+#include "./AudioBuffer.h"
+
+
+class AudioCache
+{
+public:
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     *
+     *  \param us_MaxBytes The maximum bytes of cached audio, 0 to disable.
+     */
+    
+    AudioCache(size_t us_MaxBytes) noexcept;
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~AudioCache() noexcept;
+    
+    //*************************************************************************************
+    // Add
+    //*************************************************************************************
+    
+    /**
+     *  Add audio to the cache. The least recently used audio is removed if 
+     *  the cache is full. This function is thread safe.
+     *
+     *  \param s_Key The key identifying the audio content.
+     *  \param c_Audio The audio to cache.
+     *  \param u64_LatencyMS The milliseconds taken to create the audio.
+     */
+    
+    void Add(std::string const& s_Key, AudioBuffer const& c_Audio, MRH_Uint64 u64_LatencyMS) noexcept;
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get cached audio. This function is thread safe.
+     *
+     *  \param s_Key The key identifying the audio content.
+     *  \param c_Audio The audio buffer to replace with the cached audio.
+     *
+     *  \return true if the audio was cached, false if not.
+     */
+    
+    bool GetAudio(std::string const& s_Key, AudioBuffer& c_Audio);
+    
+    /**
+     *  Check if audio is cached without using it. This function is thread safe.
+     *
+     *  \param s_Key The key identifying the audio content.
+     *
+     *  \return true if the audio is cached, false if not.
+     */
+    
+    bool GetCached(std::string const& s_Key) noexcept;
+    
+    /**
+     *  Check if the cache is used.
+     *
+     *  \return true if used, false if not.
+     */
+    
+    bool GetEnabled() const noexcept;
+    
+private:
+    
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+    
+    struct Entry
+    {
+        std::string s_Key;
+        MRH_Uint32 u32_KHz;
+        MRH_Uint64 u64_LatencyMS;
+        std::shared_ptr<const std::vector<MRH_Sint16>> p_Samples; // Shared with readers
+    };
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    std::mutex c_Mutex;
+    
+    std::list<Entry> l_Entry; // Most recent first
+    std::unordered_map<std::string, std::list<Entry>::iterator> m_Entry;
+    
+    size_t us_Bytes;
+    size_t us_MaxBytes;
+    
+protected:
+    
+};
+
+#endif /* AudioCache_h */
@@ -0,0 +1,506 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+// C / C++
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+// External
+#include <libmrhpsb/MRH_PSBLogger.h>
+#if MRH_SPEECH_USE_FLAC > 0
+#include <FLAC/stream_encoder.h>
+#endif
+#if MRH_SPEECH_USE_OPUS > 0
+#include <opus/opus.h>
+#include <ogg/ogg.h>
+#endif
+
+// Project
+#include "./AudioEncoder.h"
+#include "../../../Metrics.h"
+
+// Pre-defined
+#ifndef MRH_SPEECH_FLAC_COMPRESSION_LEVEL
+    #define MRH_SPEECH_FLAC_COMPRESSION_LEVEL 5
+#endif
+#ifndef MRH_SPEECH_OPUS_FRAME_MS
+    #define MRH_SPEECH_OPUS_FRAME_MS 20
+#endif
+#ifndef MRH_SPEECH_OPUS_MAX_PACKET_SIZE
+    #define MRH_SPEECH_OPUS_MAX_PACKET_SIZE 4000 // Recommended by libopus
+#endif
+
+
+namespace
+{
+#if MRH_SPEECH_USE_FLAC > 0
+    //*************************************************************************************
+    // FLAC
+    //*************************************************************************************
+    
+    FLAC__StreamEncoderWriteStatus WriteFLAC(const FLAC__StreamEncoder*, const FLAC__byte p_Buffer[], size_t us_Bytes, uint32_t, uint32_t, void* p_Output)
+    {
+        try
+        {
+            static_cast<std::string*>(p_Output)->append(reinterpret_cast<const char*>(p_Buffer), us_Bytes);
+        }
+        catch (...)
+        {
+            return FLAC__STREAM_ENCODER_WRITE_STATUS_FATAL_ERROR;
+        }
+        
+        return FLAC__STREAM_ENCODER_WRITE_STATUS_OK;
+    }
+    
+    void EncodeFLAC(AudioBuffer const& c_Audio, std::string& s_Output)
+    {
+        std::unique_ptr<FLAC__StreamEncoder, void(*)(FLAC__StreamEncoder*)> p_Encoder(FLAC__stream_encoder_new(),
+                                                                                      FLAC__stream_encoder_delete);
+        
+        if (!p_Encoder)
+        {
+            throw Exception("Failed to create FLAC encoder!");
+        }
+        
+        FLAC__stream_encoder_set_channels(p_Encoder.get(), 1); // Always mono
+        FLAC__stream_encoder_set_bits_per_sample(p_Encoder.get(), 16);
+        FLAC__stream_encoder_set_sample_rate(p_Encoder.get(), c_Audio.GetKHz());
+        FLAC__stream_encoder_set_compression_level(p_Encoder.get(), MRH_SPEECH_FLAC_COMPRESSION_LEVEL);
+        FLAC__stream_encoder_set_total_samples_estimate(p_Encoder.get(), c_Audio.GetSampleCount());
+        
+        if (FLAC__stream_encoder_init_stream(p_Encoder.get(), WriteFLAC, NULL, NULL, NULL, &s_Output) != FLAC__STREAM_ENCODER_INIT_STATUS_OK)
+        {
+            throw Exception("Failed to initialize FLAC encoder!");
+        }
+        
+        // FLAC takes 32 bit samples, convert segment wise
+        FLAC__int32 p_Samples[MRH_SPEECH_AUDIO_POOL_BLOCK_SIZE];
+        const MRH_Sint16* p_Segment;
+        size_t us_Elements;
+        
+        for (size_t i = 0; i < c_Audio.GetSegmentCount(); ++i)
+        {
+            p_Segment = c_Audio.GetSegment(i, us_Elements);
+            
+            for (size_t j = 0; j < us_Elements; ++j)
+            {
+                p_Samples[j] = p_Segment[j];
+            }
+            
+            if (FLAC__stream_encoder_process_interleaved(p_Encoder.get(), p_Samples, static_cast<uint32_t>(us_Elements)) == false)
+            {
+                throw Exception("Failed to encode FLAC audio!");
+            }
+        }
+        
+        if (FLAC__stream_encoder_finish(p_Encoder.get()) == false)
+        {
+            throw Exception("Failed to finish FLAC audio!");
+        }
+    }
+#endif
+    
+#if MRH_SPEECH_USE_OPUS > 0
+    //*************************************************************************************
+    // Opus
+    //*************************************************************************************
+    
+    class OggStream
+    {
+    public:
+        
+        OggStream(std::string& s_Output) : u64_Packet(0),
+                                           s_Output(s_Output)
+        {
+            if (ogg_stream_init(&c_Stream, 1) != 0)
+            {
+                throw Exception("Failed to initialize ogg stream!");
+            }
+        }
+        
+        ~OggStream() noexcept
+        {
+            ogg_stream_clear(&c_Stream);
+        }
+        
+        void Add(unsigned char* p_Packet, long l_Bytes, ogg_int64_t s64_Granule, bool b_Flush, bool b_End = false)
+        {
+            ogg_packet c_Packet;
+            
+            c_Packet.packet = p_Packet;
+            c_Packet.bytes = l_Bytes;
+            c_Packet.b_o_s = u64_Packet == 0 ? 1 : 0;
+            c_Packet.e_o_s = b_End == true ? 1 : 0;
+            c_Packet.granulepos = s64_Granule;
+            c_Packet.packetno = u64_Packet++;
+            
+            if (ogg_stream_packetin(&c_Stream, &c_Packet) != 0)
+            {
+                throw Exception("Failed to add ogg packet!");
+            }
+            
+            // @NOTE: Headers are required to be on their own pages
+            ogg_page c_Page;
+            
+            while ((b_Flush == true || b_End == true ? ogg_stream_flush(&c_Stream, &c_Page) : ogg_stream_pageout(&c_Stream, &c_Page)) != 0)
+            {
+                s_Output.append(reinterpret_cast<const char*>(c_Page.header), c_Page.header_len);
+                s_Output.append(reinterpret_cast<const char*>(c_Page.body), c_Page.body_len);
+            }
+        }
+        
+    private:
+        
+        ogg_stream_state c_Stream;
+        MRH_Uint64 u64_Packet;
+        std::string& s_Output;
+    };
+    
+    void EncodeOpus(AudioBuffer const& c_Audio, MRH_Uint32 u32_Bitrate, std::string& s_Output)
+    {
+        MRH_Uint32 u32_KHz = c_Audio.GetKHz();
+        
+        switch (u32_KHz)
+        {
+            case 8000:
+            case 12000:
+            case 16000:
+            case 24000:
+            case 48000:
+                break;
+            default:
+                throw Exception("Unsupported opus KHz: " + std::to_string(u32_KHz));
+        }
+        
+        int i_Error;
+        std::unique_ptr<OpusEncoder, void(*)(OpusEncoder*)> p_Encoder(opus_encoder_create(static_cast<opus_int32>(u32_KHz), 1, OPUS_APPLICATION_VOIP, &i_Error),
+                                                                      opus_encoder_destroy);
+        
+        if (i_Error != OPUS_OK || !p_Encoder)
+        {
+            throw Exception("Failed to create opus encoder: " + std::string(opus_strerror(i_Error)));
+        }
+        
+        opus_int32 s32_Lookahead = 0;
+        
+        opus_encoder_ctl(p_Encoder.get(), OPUS_SET_BITRATE(static_cast<opus_int32>(u32_Bitrate)));
+        opus_encoder_ctl(p_Encoder.get(), OPUS_SET_SIGNAL(OPUS_SIGNAL_VOICE));
+        opus_encoder_ctl(p_Encoder.get(), OPUS_GET_LOOKAHEAD(&s32_Lookahead));
+        
+        // @NOTE: Ogg opus granule positions always use 48 KHz
+        MRH_Uint32 u32_Scale = 48000 / u32_KHz;
+        MRH_Uint16 u16_PreSkip = static_cast<MRH_Uint16>(s32_Lookahead * u32_Scale);
+        
+        OggStream c_Stream(s_Output);
+        
+        /**
+         *  Header
+         */
+        
+        unsigned char p_Head[19] = { 'O', 'p', 'u', 's', 'H', 'e', 'a', 'd',
+                                     1, // Version
+                                     1, // Channels
+                                     static_cast<unsigned char>(u16_PreSkip & 0xFF),
+                                     static_cast<unsigned char>((u16_PreSkip >> 8) & 0xFF),
+                                     static_cast<unsigned char>(u32_KHz & 0xFF),
+                                     static_cast<unsigned char>((u32_KHz >> 8) & 0xFF),
+                                     static_cast<unsigned char>((u32_KHz >> 16) & 0xFF),
+                                     static_cast<unsigned char>((u32_KHz >> 24) & 0xFF),
+                                     0, 0, // Output gain
+                                     0 }; // Channel mapping
+        unsigned char p_Tags[16] = { 'O', 'p', 'u', 's', 'T', 'a', 'g', 's',
+                                     0, 0, 0, 0, // Vendor string length
+                                     0, 0, 0, 0 }; // Comment count
+        
+        c_Stream.Add(p_Head, sizeof(p_Head), 0, true);
+        c_Stream.Add(p_Tags, sizeof(p_Tags), 0, true);
+        
+        /**
+         *  Audio
+         */
+        
+        size_t us_FrameSize = (u32_KHz * MRH_SPEECH_OPUS_FRAME_MS) / 1000;
+        size_t us_Total = c_Audio.GetSampleCount();
+        std::vector<opus_int16> v_Frame(us_FrameSize, 0);
+        unsigned char p_Packet[MRH_SPEECH_OPUS_MAX_PACKET_SIZE];
+        
+        const MRH_Sint16* p_Segment;
+        size_t us_Elements;
+        size_t us_Fill = 0;
+        size_t us_Encoded = 0;
+        size_t us_Chunk;
+        opus_int32 s32_Bytes;
+        
+        for (size_t i = 0; i < c_Audio.GetSegmentCount(); ++i)
+        {
+            p_Segment = c_Audio.GetSegment(i, us_Elements);
+            
+            while (us_Elements > 0)
+            {
+                us_Chunk = us_FrameSize - us_Fill;
+                
+                if (us_Chunk > us_Elements)
+                {
+                    us_Chunk = us_Elements;
+                }
+                
+                std::copy(p_Segment, p_Segment + us_Chunk, v_Frame.begin() + us_Fill);
+                
+                p_Segment += us_Chunk;
+                us_Elements -= us_Chunk;
+                us_Fill += us_Chunk;
+                
+                if (us_Fill < us_FrameSize)
+                {
+                    continue;
+                }
+                
+                if ((s32_Bytes = opus_encode(p_Encoder.get(), v_Frame.data(), static_cast<int>(us_FrameSize), p_Packet, sizeof(p_Packet))) < 0)
+                {
+                    throw Exception("Failed to encode opus audio: " + std::string(opus_strerror(s32_Bytes)));
+                }
+                
+                us_Fill = 0;
+                us_Encoded += us_FrameSize;
+                
+                // Last full frame ends the stream if nothing remains
+                if (us_Encoded == us_Total)
+                {
+                    c_Stream.Add(p_Packet, s32_Bytes, u16_PreSkip + (us_Encoded * u32_Scale), true, true);
+                    return;
+                }
+                
+                c_Stream.Add(p_Packet, s32_Bytes, u16_PreSkip + (us_Encoded * u32_Scale), false);
+            }
+        }
+        
+        // Pad the remaining partial frame, the granule position marks the real end
+        std::fill(v_Frame.begin() + us_Fill, v_Frame.end(), 0);
+        
+        if ((s32_Bytes = opus_encode(p_Encoder.get(), v_Frame.data(), static_cast<int>(us_FrameSize), p_Packet, sizeof(p_Packet))) < 0)
+        {
+            throw Exception("Failed to encode opus audio: " + std::string(opus_strerror(s32_Bytes)));
+        }
+        
+        c_Stream.Add(p_Packet, s32_Bytes, u16_PreSkip + (us_Total * u32_Scale), true, true);
+    }
+#endif
+}
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+AudioEncoder::AudioEncoder(Encoding e_Encoding, MRH_Uint32 u32_Bitrate) : u64_NextID(0),
+                                                                          u64_CancelID(0),
+                                                                          b_Update(true),
+                                                                          e_Encoding(e_Encoding),
+                                                                          u32_Bitrate(u32_Bitrate)
+{
+    switch (e_Encoding)
+    {
+#if MRH_SPEECH_USE_FLAC > 0
+        case FLAC:
+#endif
+#if MRH_SPEECH_USE_OPUS > 0
+        case OGG_OPUS:
+#endif
+        case LINEAR16:
+            break;
+            
+        default:
+            MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::WARNING, "Audio encoding " + std::to_string(e_Encoding) + " not available, using LINEAR16!",
+                                           "AudioEncoder.cpp", __LINE__);
+            this->e_Encoding = LINEAR16;
+            break;
+    }
+    
+    try
+    {
+        c_Thread = std::thread(Update, this);
+    }
+    catch (std::exception& e)
+    {
+        throw Exception("Failed to start audio encoder thread: " + std::string(e.what()));
+    }
+}
+
+AudioEncoder::~AudioEncoder() noexcept
+{
+    // @NOTE: Remaining jobs are cancelled, their callbacks are still called
+    {
+        std::lock_guard<std::mutex> c_Guard(c_Mutex);
+        
+        u64_CancelID = u64_NextID;
+        b_Update = false;
+    }
+    
+    c_Condition.notify_all();
+    c_Thread.join();
+}
+
+//*************************************************************************************
+// Update
+//*************************************************************************************
+
+void AudioEncoder::Update(AudioEncoder* p_Instance) noexcept
+{
+    Metrics& c_Metrics = Metrics::Singleton();
+    std::chrono::steady_clock::time_point c_Start;
+    
+    while (true)
+    {
+        std::unique_lock<std::mutex> c_Lock(p_Instance->c_Mutex);
+        
+        p_Instance->c_Condition.wait(c_Lock, [p_Instance]()
+        {
+            return p_Instance->dq_Job.size() > 0 || p_Instance->b_Update == false;
+        });
+        
+        if (p_Instance->dq_Job.size() == 0)
+        {
+            return;
+        }
+        
+        Job c_Job(std::move(p_Instance->dq_Job.front()));
+        p_Instance->dq_Job.pop_front();
+        
+        bool b_Cancelled = c_Job.u64_ID < p_Instance->u64_CancelID;
+        
+        // @NOTE: Callbacks might add new audio, never hold the lock
+        c_Lock.unlock();
+        
+        if (b_Cancelled == true)
+        {
+            c_Job.f_Callback(NULL);
+            continue;
+        }
+        
+        Output c_Output;
+        c_Output.e_Encoding = p_Instance->e_Encoding;
+        c_Output.u32_KHz = c_Job.c_Audio.GetKHz();
+        
+        try
+        {
+            c_Start = std::chrono::steady_clock::now();
+            
+            p_Instance->Encode(c_Job.c_Audio, c_Output.s_Content);
+            
+            c_Metrics.Add(Metrics::AUDIO_ENCODE);
+            c_Metrics.Add(Metrics::AUDIO_ENCODE_TIME_US, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - c_Start).count());
+            c_Metrics.Add(Metrics::AUDIO_ENCODE_INPUT_BYTES, c_Job.c_Audio.GetSampleCount() * sizeof(MRH_Sint16));
+            c_Metrics.Add(Metrics::AUDIO_ENCODE_OUTPUT_BYTES, c_Output.s_Content.size());
+        }
+        catch (std::exception& e)
+        {
+            MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::ERROR, e.what(),
+                                           "AudioEncoder.cpp", __LINE__);
+            c_Job.f_Callback(NULL);
+            continue;
+        }
+        
+        // Encoded audio is no longer needed, return the blocks before the upload
+        c_Job.c_Audio.Clear(c_Output.u32_KHz);
+        
+        // Cancelled while encoding?
+        c_Lock.lock();
+        b_Cancelled = c_Job.u64_ID < p_Instance->u64_CancelID;
+        c_Lock.unlock();
+        
+        c_Job.f_Callback(b_Cancelled == true ? NULL : &c_Output);
+    }
+}
+
+//*************************************************************************************
+// Encode
+//*************************************************************************************
+
+void AudioEncoder::Encode(AudioBuffer&& c_Audio, Callback const& f_Callback)
+{
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+    
+    if (b_Update == false)
+    {
+        throw Exception("Audio encoder stopped!");
+    }
+    
+    try
+    {
+        dq_Job.push_back({ u64_NextID, std::move(c_Audio), f_Callback });
+        ++u64_NextID;
+    }
+    catch (std::exception& e)
+    {
+        throw Exception("Failed to add audio to encode: " + std::string(e.what()));
+    }
+    
+    c_Condition.notify_one();
+}
+
+void AudioEncoder::Encode(AudioBuffer const& c_Audio, std::string& s_Output) const
+{
+    s_Output.clear();
+    
+    switch (e_Encoding)
+    {
+#if MRH_SPEECH_USE_FLAC > 0
+        case FLAC:
+            EncodeFLAC(c_Audio, s_Output);
+            break;
+#endif
+#if MRH_SPEECH_USE_OPUS > 0
+        case OGG_OPUS:
+            EncodeOpus(c_Audio, u32_Bitrate, s_Output);
+            break;
+#endif
+            
+        default:
+        {
+            const MRH_Sint16* p_Segment;
+            size_t us_Elements;
+            
+            s_Output.reserve(c_Audio.GetSampleCount() * sizeof(MRH_Sint16));
+            
+            for (size_t i = 0; i < c_Audio.GetSegmentCount(); ++i)
+            {
+                p_Segment = c_Audio.GetSegment(i, us_Elements);
+                s_Output.append(reinterpret_cast<const char*>(p_Segment), us_Elements * sizeof(MRH_Sint16));
+            }
+            break;
+        }
+    }
+}
+
+//*************************************************************************************
+// Cancel
+//*************************************************************************************
+
+void AudioEncoder::Cancel() noexcept
+{
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+    u64_CancelID = u64_NextID;
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+AudioEncoder::Encoding AudioEncoder::GetEncoding() const noexcept
+{
+    return e_Encoding;
+}
@@ -0,0 +1,180 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#ifndef AudioEncoder_h
+#define AudioEncoder_h
+
+// C / C++
+#include <string>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+// External
+#include <MRH_Typedefs.h>
+
+// Project
+#include "./AudioBuffer.h"
+
+
+class AudioEncoder
+{
+public:
+    
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+    
+    enum Encoding
+    {
+        LINEAR16 = 0,
+        FLAC = 1,
+        OGG_OPUS = 2,
+        
+        ENCODING_MAX = OGG_OPUS,
+        
+        ENCODING_COUNT = ENCODING_MAX + 1
+    };
+    
+    struct Output
+    {
+        Encoding e_Encoding;
+        MRH_Uint32 u32_KHz;
+        std::string s_Content;
+    };
+    
+    /**
+     *  Called with the encoded audio on the encoder thread, NULL if encoding 
+     *  failed or was cancelled.
+     */
+    
+    typedef std::function<void(Output* p_Output)> Callback;
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     *
+     *  \param e_Encoding The encoding to use. Encodings not built into the 
+     *                    service fall back to LINEAR16.
+     *  \param u32_Bitrate The opus bitrate in bits per second.
+     */
+    
+    AudioEncoder(Encoding e_Encoding, MRH_Uint32 u32_Bitrate);
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~AudioEncoder() noexcept;
+    
+    //*************************************************************************************
+    // Encode
+    //*************************************************************************************
+    
+    /**
+     *  Add audio to encode on the encoder thread. This function is thread safe.
+     *
+     *  \param c_Audio The audio to encode. The audio is moved.
+     *  \param f_Callback The callback called once encoded.
+     */
+    
+    void Encode(AudioBuffer&& c_Audio, Callback const& f_Callback);
+    
+    //*************************************************************************************
+    // Cancel
+    //*************************************************************************************
+    
+    /**
+     *  Cancel all added audio. Callbacks of cancelled audio are still called 
+     *  on the encoder thread. This function is thread safe.
+     */
+    
+    void Cancel() noexcept;
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the used encoding.
+     *
+     *  \return The audio encoding.
+     */
+    
+    Encoding GetEncoding() const noexcept;
+    
+private:
+    
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+    
+    struct Job
+    {
+        MRH_Uint64 u64_ID;
+        AudioBuffer c_Audio;
+        Callback f_Callback;
+    };
+    
+    //*************************************************************************************
+    // Update
+    //*************************************************************************************
+    
+    /**
+     *  Encode added audio.
+     *
+     *  \param p_Instance The encoder instance to update.
+     */
+    
+    static void Update(AudioEncoder* p_Instance) noexcept;
+    
+    //*************************************************************************************
+    // Encode
+    //*************************************************************************************
+    
+    /**
+     *  Encode audio.
+     *
+     *  \param c_Audio The audio to encode.
+     *  \param s_Output The encoded audio.
+     */
+    
+    void Encode(AudioBuffer const& c_Audio, std::string& s_Output) const;
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    std::thread c_Thread;
+    std::mutex c_Mutex;
+    std::condition_variable c_Condition;
+    std::deque<Job> dq_Job;
+    MRH_Uint64 u64_NextID;
+    MRH_Uint64 u64_CancelID; // Jobs before are cancelled
+    bool b_Update;
+    
+    Encoding e_Encoding;
+    MRH_Uint32 u32_Bitrate;
+    
+protected:
+    
+};
+
+#endif /* AudioEncoder_h */
@@ -0,0 +1,155 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+// C / C++
+#include <limits>
+
+// External
+
+// Project
+#include "./AudioPool.h"
+#include "../../../Metrics.h"
+
+// Pre-defined
+#ifndef MRH_SPEECH_AUDIO_POOL_SLAB_SIZE
+    #define MRH_SPEECH_AUDIO_POOL_SLAB_SIZE 16
+#endif
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+AudioPool::AudioPool() noexcept : p_Free(NULL),
+                                  us_Allocated(0),
+                                  us_Used(0)
+{
+    for (size_t i = 0; i < USE_COUNT; ++i)
+    {
+        p_Limit[i] = std::numeric_limits<size_t>::max() / USE_COUNT;
+        p_UseUsed[i] = 0;
+    }
+}
+
+AudioPool::~AudioPool() noexcept
+{}
+
+//*************************************************************************************
+// Singleton
+//*************************************************************************************
+
+AudioPool& AudioPool::Singleton() noexcept
+{
+    static AudioPool c_AudioPool;
+    return c_AudioPool;
+}
+
+//*************************************************************************************
+// Acquire
+//*************************************************************************************
+
+AudioPool::Block* AudioPool::Acquire(Use e_Use)
+{
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+    
+    if (p_UseUsed[e_Use] >= p_Limit[e_Use])
+    {
+        Metrics::Singleton().Add(Metrics::AUDIO_POOL_EXHAUSTED);
+        throw Exception(e_Use == CAPTURE ? "Capture audio memory limit reached!" : "Playback audio memory limit reached!");
+    }
+    
+    if (p_Free == NULL)
+    {
+        // Empty, grow by a slab within the combined limit
+        size_t us_Limit = 0;
+        size_t us_Blocks = MRH_SPEECH_AUDIO_POOL_SLAB_SIZE;
+        
+        for (size_t i = 0; i < USE_COUNT; ++i)
+        {
+            us_Limit += p_Limit[i];
+        }
+        
+        // @NOTE: Only reached if a limit was lowered below the blocks in use
+        if (us_Allocated >= us_Limit)
+        {
+            Metrics::Singleton().Add(Metrics::AUDIO_POOL_EXHAUSTED);
+            throw Exception("Audio memory limit reached!");
+        }
+        else if ((us_Limit - us_Allocated) < us_Blocks)
+        {
+            us_Blocks = us_Limit - us_Allocated;
+        }
+        
+        try
+        {
+            v_Slab.emplace_back(new Block[us_Blocks]);
+        }
+        catch (std::exception& e)
+        {
+            throw Exception("Failed to grow audio pool: " + std::string(e.what()));
+        }
+        
+        Block* p_Slab = v_Slab.back().get();
+        
+        for (size_t i = 0; i < us_Blocks; ++i)
+        {
+            p_Slab[i].p_Next = p_Free;
+            p_Free = &(p_Slab[i]);
+        }
+        
+        us_Allocated += us_Blocks;
+    }
+    
+    Block* p_Block = p_Free;
+    p_Free = p_Block->p_Next;
+    p_Block->e_Use = e_Use;
+    
+    ++p_UseUsed[e_Use];
+    Metrics::Singleton().SetMax(Metrics::AUDIO_POOL_HIGH_WATER, ++us_Used);
+    
+    return p_Block;
+}
+
+//*************************************************************************************
+// Release
+//*************************************************************************************
+
+void AudioPool::Release(Block* p_Block) noexcept
+{
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+    
+    p_Block->p_Next = p_Free;
+    p_Free = p_Block;
+    
+    --p_UseUsed[p_Block->e_Use];
+    --us_Used;
+}
+
+//*************************************************************************************
+// Setters
+//*************************************************************************************
+
+void AudioPool::SetLimit(Use e_Use, size_t us_Bytes) noexcept
+{
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+    
+    p_Limit[e_Use] = us_Bytes / sizeof(Block);
+    
+    // @NOTE: At least one block, audio buffers need storage
+    if (p_Limit[e_Use] == 0)
+    {
+        p_Limit[e_Use] = 1;
+    }
+}
@@ -0,0 +1,151 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#ifndef AudioPool_h
+#define AudioPool_h
+
+// C / C++
+#include <mutex>
+#include <vector>
+#include <memory>
+
+// External
+#include <MRH_Typedefs.h>
+
+// Project
+#include "../../../Exception.h"
+
+// Pre-defined
+#ifndef MRH_SPEECH_AUDIO_POOL_BLOCK_SIZE
+    #define MRH_SPEECH_AUDIO_POOL_BLOCK_SIZE 4096 // Samples per block
+#endif
+
+
+class AudioPool
+{
+public:
+    
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+    
+    enum Use
+    {
+        CAPTURE = 0,
+        PLAYBACK = 1,
+        
+        USE_MAX = PLAYBACK,
+        
+        USE_COUNT = USE_MAX + 1
+    };
+    
+    struct Block
+    {
+        Block* p_Next;
+        Use e_Use;
+        MRH_Sint16 p_Samples[MRH_SPEECH_AUDIO_POOL_BLOCK_SIZE];
+    };
+    
+    //*************************************************************************************
+    // Singleton
+    //*************************************************************************************
+    
+    /**
+     *  Get the class instance. This function is thread safe.
+     *
+     *  \return The class instance.
+     */
+    
+    static AudioPool& Singleton() noexcept;
+    
+    //*************************************************************************************
+    // Acquire
+    //*************************************************************************************
+    
+    /**
+     *  Acquire a audio block. This function is thread safe.
+     *
+     *  \param e_Use The use of the audio block, limited separately.
+     *
+     *  \return The audio block.
+     */
+    
+    Block* Acquire(Use e_Use);
+    
+    //*************************************************************************************
+    // Release
+    //*************************************************************************************
+    
+    /**
+     *  Return a audio block to the pool. This function is thread safe.
+     *
+     *  \param p_Block The audio block to return.
+     */
+    
+    void Release(Block* p_Block) noexcept;
+    
+    //*************************************************************************************
+    // Setters
+    //*************************************************************************************
+    
+    /**
+     *  Set the maximum memory used for audio blocks of a use. Already acquired 
+     *  blocks are kept. This function is thread safe.
+     *
+     *  \param e_Use The use to limit.
+     *  \param us_Bytes The memory limit in bytes.
+     */
+    
+    void SetLimit(Use e_Use, size_t us_Bytes) noexcept;
+    
+private:
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     */
+    
+    AudioPool() noexcept;
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~AudioPool() noexcept;
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    std::mutex c_Mutex;
+    Block* p_Free;
+    std::vector<std::unique_ptr<Block[]>> v_Slab;
+    
+    size_t us_Allocated;
+    size_t us_Used;
+    
+    // @NOTE: Uses never take blocks from each other, only free 
+    //        blocks are shared
+    size_t p_Limit[USE_COUNT];
+    size_t p_UseUsed[USE_COUNT];
+    
+protected:
+    
+};
+
+#endif /* AudioPool_h */
@@ -0,0 +1,157 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+// C / C++
+#include <cstring>
+
+// External
+
+// Project
+#include "./AudioRing.h"
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+AudioRing::AudioRing(size_t us_Capacity) : u64_Write(0)
+{
+    if (us_Capacity == 0)
+    {
+        throw Exception("Invalid audio ring capacity!");
+    }
+    
+    // Power of two, index wrap is a mask
+    size_t us_Slots = 1;
+    
+    while (us_Slots < us_Capacity)
+    {
+        us_Slots <<= 1;
+    }
+    
+    us_Mask = us_Slots - 1;
+    
+    try
+    {
+        v_Samples.resize(us_Slots, 0);
+    }
+    catch (std::exception& e)
+    {
+        throw Exception("Failed to allocate audio ring: " + std::string(e.what()));
+    }
+}
+
+AudioRing::~AudioRing() noexcept
+{}
+
+//*************************************************************************************
+// Clear
+//*************************************************************************************
+
+void AudioRing::Clear() noexcept
+{
+    u64_Write = 0;
+}
+
+//*************************************************************************************
+// Write
+//*************************************************************************************
+
+void AudioRing::Write(const MRH_Sint16* p_Buffer, size_t us_Elements) noexcept
+{
+    size_t us_Capacity = v_Samples.size();
+    
+    // Only the newest samples fit
+    if (us_Elements > us_Capacity)
+    {
+        u64_Write += us_Elements - us_Capacity;
+        p_Buffer += us_Elements - us_Capacity;
+        us_Elements = us_Capacity;
+    }
+    
+    size_t us_Start = static_cast<size_t>(u64_Write) & us_Mask;
+    size_t us_First = us_Capacity - us_Start;
+    
+    if (us_First > us_Elements)
+    {
+        us_First = us_Elements;
+    }
+    
+    // Copy up to the end, then wrap
+    std::memcpy(&(v_Samples[us_Start]), p_Buffer, us_First * sizeof(MRH_Sint16));
+    
+    if (us_First < us_Elements)
+    {
+        std::memcpy(&(v_Samples[0]), p_Buffer + us_First, (us_Elements - us_First) * sizeof(MRH_Sint16));
+    }
+    
+    u64_Write += us_Elements;
+}
+
+//*************************************************************************************
+// Splice
+//*************************************************************************************
+
+size_t AudioRing::Splice(AudioBuffer& c_Buffer, size_t us_Elements)
+{
+    size_t us_Available = GetAvailable();
+    
+    if (us_Elements > us_Available)
+    {
+        us_Elements = us_Available;
+    }
+    
+    if (us_Elements == 0)
+    {
+        return 0;
+    }
+    
+    size_t us_Start = static_cast<size_t>(u64_Write - us_Elements) & us_Mask;
+    size_t us_First = v_Samples.size() - us_Start;
+    
+    if (us_First > us_Elements)
+    {
+        us_First = us_Elements;
+    }
+    
+    // @NOTE: At most two contiguous copies, the history is never linearized
+    c_Buffer.AddAudio(&(v_Samples[us_Start]), us_First);
+    
+    if (us_First < us_Elements)
+    {
+        c_Buffer.AddAudio(&(v_Samples[0]), us_Elements - us_First);
+    }
+    
+    return us_Elements;
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+size_t AudioRing::GetAvailable() const noexcept
+{
+    if (u64_Write < v_Samples.size())
+    {
+        return static_cast<size_t>(u64_Write);
+    }
+    
+    return v_Samples.size();
+}
+
+size_t AudioRing::GetCapacity() const noexcept
+{
+    return v_Samples.size();
+}
@@ -0,0 +1,126 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#ifndef AudioRing_h
+#define AudioRing_h
+
+// C / C++
+#include <vector>
+
+// External
+#include <MRH_Typedefs.h>
+
+// Project
+#include "./AudioBuffer.h"
+
+
+class AudioRing
+{
+public:
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     *
+     *  \param us_Capacity The amount of samples the ring keeps. Rounded up to the 
+     *                     next power of two.
+     */
+    
+    AudioRing(size_t us_Capacity);
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~AudioRing() noexcept;
+    
+    //*************************************************************************************
+    // Clear
+    //*************************************************************************************
+    
+    /**
+     *  Remove all samples.
+     */
+    
+    void Clear() noexcept;
+    
+    //*************************************************************************************
+    // Write
+    //*************************************************************************************
+    
+    /**
+     *  Add samples, overwriting the oldest samples once full.
+     *
+     *  \param p_Buffer The audio buffer.
+     *  \param us_Elements The elements in the audio buffer.
+     */
+    
+    void Write(const MRH_Sint16* p_Buffer, size_t us_Elements) noexcept;
+    
+    //*************************************************************************************
+    // Splice
+    //*************************************************************************************
+    
+    /**
+     *  Add the most recent samples to a audio buffer.
+     *
+     *  \param c_Buffer The audio buffer to add to.
+     *  \param us_Elements The amount of most recent samples to add.
+     *
+     *  \return The amount of samples added.
+     */
+    
+    size_t Splice(AudioBuffer& c_Buffer, size_t us_Elements);
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the amount of samples currently kept.
+     *
+     *  \return The available sample count.
+     */
+    
+    size_t GetAvailable() const noexcept;
+    
+    /**
+     *  Get the amount of samples the ring can keep.
+     *
+     *  \return The ring capacity.
+     */
+    
+    size_t GetCapacity() const noexcept;
+    
+private:
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    // @NOTE: The write position only grows, the ring is owned by the 
+    //        capture thread and never locked
+    MRH_Uint64 u64_Write;
+    size_t us_Mask;
+    std::vector<MRH_Sint16> v_Samples;
+    
+protected:
+    
+};
+
+#endif /* AudioRing_h */
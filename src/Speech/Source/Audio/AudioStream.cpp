@@ -0,0 +1,171 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <cstring>
+
+// External
+
+// Project
+#include "./AudioStream.h"
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+AudioStream::AudioStream(MRH_Uint32 u32_KHz) noexcept : us_ReadPos(0),
+                                                        b_Ended(false),
+                                                        b_Closed(false),
+                                                        u32_KHz(u32_KHz)
+{}
+
+AudioStream::~AudioStream() noexcept
+{}
+
+//*************************************************************************************
+// Write
+//*************************************************************************************
+
+void AudioStream::Write(const MRH_Sint16* p_Buffer, size_t us_Elements)
+{
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+    
+    if (b_Ended == true || b_Closed == true || us_Elements == 0)
+    {
+        return;
+    }
+    
+    try
+    {
+        v_Samples.insert(v_Samples.end(), p_Buffer, p_Buffer + us_Elements);
+    }
+    catch (std::exception& e)
+    {
+        throw Exception("Failed to add stream audio: " + std::string(e.what()));
+    }
+    
+    if (f_Listener)
+    {
+        f_Listener();
+    }
+}
+
+void AudioStream::End() noexcept
+{
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+    
+    if (b_Ended == true)
+    {
+        return;
+    }
+    
+    b_Ended = true;
+    
+    if (f_Listener)
+    {
+        f_Listener();
+    }
+}
+
+//*************************************************************************************
+// Read
+//*************************************************************************************
+
+bool AudioStream::Read(std::vector<MRH_Sint16>& v_Buffer, size_t us_MaxElements, bool& b_Finished) noexcept
+{
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+    
+    size_t us_Available = v_Samples.size() - us_ReadPos;
+    
+    if (us_Available == 0)
+    {
+        b_Finished = (b_Ended == true || b_Closed == true);
+        return false;
+    }
+    else if (us_Available > us_MaxElements)
+    {
+        us_Available = us_MaxElements;
+    }
+    
+    try
+    {
+        v_Buffer.assign(v_Samples.begin() + us_ReadPos,
+                        v_Samples.begin() + us_ReadPos + us_Available);
+    }
+    catch (...)
+    {
+        return false;
+    }
+    
+    us_ReadPos += us_Available;
+    
+    // Everything read, reuse the buffer
+    if (us_ReadPos == v_Samples.size())
+    {
+        v_Samples.clear();
+        us_ReadPos = 0;
+        
+        b_Finished = (b_Ended == true || b_Closed == true);
+    }
+    else
+    {
+        b_Finished = false;
+    }
+    
+    return true;
+}
+
+void AudioStream::Close() noexcept
+{
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+    
+    b_Closed = true;
+    
+    v_Samples.clear();
+    us_ReadPos = 0;
+}
+
+//*************************************************************************************
+// Listener
+//*************************************************************************************
+
+void AudioStream::SetListener(std::function<void()> const& f_Listener) noexcept
+{
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+    this->f_Listener = f_Listener;
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+MRH_Uint32 AudioStream::GetKHz() const noexcept
+{
+    return u32_KHz;
+}
+
+bool AudioStream::GetEnded() noexcept
+{
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+    return b_Ended;
+}
+
+bool AudioStream::GetClosed() noexcept
+{
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+    return b_Ended == true || b_Closed == true;
+}
@@ -0,0 +1,159 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef AudioStream_h
+#define AudioStream_h
+
+// C / C++
+#include <vector>
+#include <mutex>
+#include <functional>
+
+// External
+#include <MRH_Typedefs.h>
+
+// Project
+#include "../../../Exception.h"
+
+
+class AudioStream
+{
+public:
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     *
+     *  \param u32_KHz The audio stream KHz.
+     */
+    
+    AudioStream(MRH_Uint32 u32_KHz) noexcept;
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~AudioStream() noexcept;
+    
+    //*************************************************************************************
+    // Write
+    //*************************************************************************************
+    
+    /**
+     *  Add audio to the stream. Audio added after the stream was ended or 
+     *  closed is ignored. This function is thread safe.
+     *
+     *  \param p_Buffer The audio buffer.
+     *  \param us_Elements The elements in the audio buffer.
+     */
+    
+    void Write(const MRH_Sint16* p_Buffer, size_t us_Elements);
+    
+    /**
+     *  Mark the end of the audio. This function is thread safe.
+     */
+    
+    void End() noexcept;
+    
+    //*************************************************************************************
+    // Read
+    //*************************************************************************************
+    
+    /**
+     *  Move available audio to a buffer. This function is thread safe.
+     *
+     *  \param v_Buffer The buffer to replace with the available audio.
+     *  \param us_MaxElements The maximum amount of elements to read.
+     *  \param b_Finished Set to true if the stream ended and all audio was read.
+     *
+     *  \return true if audio was read, false if not.
+     */
+    
+    bool Read(std::vector<MRH_Sint16>& v_Buffer, size_t us_MaxElements, bool& b_Finished) noexcept;
+    
+    /**
+     *  Close the stream from the reading side. No more audio is accepted. 
+     *  This function is thread safe.
+     */
+    
+    void Close() noexcept;
+    
+    //*************************************************************************************
+    // Listener
+    //*************************************************************************************
+    
+    /**
+     *  Set the listener called when audio was added or the stream ended. The 
+     *  listener is called while the stream is locked and may not use the stream. 
+     *  This function is thread safe.
+     *
+     *  \param f_Listener The listener to set, empty to remove.
+     */
+    
+    void SetListener(std::function<void()> const& f_Listener) noexcept;
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the audio stream KHz.
+     *
+     *  \return The audio stream KHz.
+     */
+    
+    MRH_Uint32 GetKHz() const noexcept;
+    
+    /**
+     *  Check if the stream was ended by the writing side. This function is 
+     *  thread safe.
+     *
+     *  \return true if ended, false if not.
+     */
+    
+    bool GetEnded() noexcept;
+    
+    /**
+     *  Check if the stream was ended or closed. This function is thread safe.
+     *
+     *  \return true if closed, false if not.
+     */
+    
+    bool GetClosed() noexcept;
+    
+private:
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    std::mutex c_Mutex;
+    std::vector<MRH_Sint16> v_Samples;
+    size_t us_ReadPos;
+    bool b_Ended;
+    bool b_Closed;
+    std::function<void()> f_Listener;
+    
+    MRH_Uint32 u32_KHz;
+    
+protected:
+    
+};
+
+#endif /* AudioStream_h */
@@ -0,0 +1,247 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+// C / C++
+#include <vector>
+#include <cstdlib>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// External
+
+// Project
+#include "./AudioTrim.h"
+
+// Pre-defined
+#ifndef MRH_SPEECH_TRIM_FRAME_MS
+    #define MRH_SPEECH_TRIM_FRAME_MS 10
+#endif
+
+
+namespace
+{
+    //*************************************************************************************
+    // Peak
+    //*************************************************************************************
+    
+    MRH_Uint16 GetPeak(const MRH_Sint16* p_Buffer, size_t us_Elements) noexcept
+    {
+        size_t i = 0;
+        MRH_Uint16 u16_Peak = 0;
+        
+#if defined(__AVX2__)
+        // @NOTE: abs(-32768) stays 0x8000, which is correct as unsigned
+        __m256i c_Peak = _mm256_setzero_si256();
+        
+        for (; (i + 16) <= us_Elements; i += 16)
+        {
+            c_Peak = _mm256_max_epu16(c_Peak, _mm256_abs_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p_Buffer + i))));
+        }
+        
+        alignas(32) MRH_Uint16 p_Lane[16];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(p_Lane), c_Peak);
+        
+        for (size_t j = 0; j < 16; ++j)
+        {
+            u16_Peak = p_Lane[j] > u16_Peak ? p_Lane[j] : u16_Peak;
+        }
+#elif defined(__ARM_NEON)
+        // @NOTE: Saturating, abs(-32768) is 32767
+        int16x8_t c_Peak = vdupq_n_s16(0);
+        
+        for (; (i + 8) <= us_Elements; i += 8)
+        {
+            c_Peak = vmaxq_s16(c_Peak, vqabsq_s16(vld1q_s16(p_Buffer + i)));
+        }
+        
+        MRH_Sint16 p_Lane[8];
+        vst1q_s16(p_Lane, c_Peak);
+        
+        for (size_t j = 0; j < 8; ++j)
+        {
+            u16_Peak = static_cast<MRH_Uint16>(p_Lane[j]) > u16_Peak ? static_cast<MRH_Uint16>(p_Lane[j]) : u16_Peak;
+        }
+#endif
+        
+        // Remaining elements
+        for (; i < us_Elements; ++i)
+        {
+            MRH_Uint16 u16_Sample = static_cast<MRH_Uint16>(std::abs(static_cast<int>(p_Buffer[i])));
+            u16_Peak = u16_Sample > u16_Peak ? u16_Sample : u16_Peak;
+        }
+        
+        return u16_Peak;
+    }
+}
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+AudioTrim::AudioTrim(MRH_Uint32 u32_Threshold, MRH_Uint32 u32_PaddingMS, MRH_Uint32 u32_MaxPauseMS) noexcept : u16_Threshold(u32_Threshold > 0xFFFF ? 0xFFFF : static_cast<MRH_Uint16>(u32_Threshold)),
+                                                                                                               u32_PaddingFrames(u32_PaddingMS / MRH_SPEECH_TRIM_FRAME_MS),
+                                                                                                               u32_MaxPauseFrames(u32_MaxPauseMS / MRH_SPEECH_TRIM_FRAME_MS)
+{}
+
+AudioTrim::~AudioTrim() noexcept
+{}
+
+//*************************************************************************************
+// Process
+//*************************************************************************************
+
+void AudioTrim::Process(AudioBuffer const& c_Input, AudioBuffer& c_Output) const
+{
+    c_Output.Clear(c_Input.GetKHz());
+    
+    size_t us_FrameSize = (static_cast<size_t>(c_Input.GetKHz()) * MRH_SPEECH_TRIM_FRAME_MS) / 1000;
+    size_t us_Total = c_Input.GetSampleCount();
+    
+    if (us_FrameSize == 0 || us_Total == 0)
+    {
+        return;
+    }
+    
+    /**
+     *  Frames
+     */
+    
+    // Silent frames by peak amplitude, frames span segments
+    std::vector<bool> v_Silent;
+    MRH_Uint16 u16_Peak = 0;
+    MRH_Uint16 u16_ChunkPeak;
+    size_t us_Fill = 0;
+    
+    try
+    {
+        v_Silent.reserve((us_Total / us_FrameSize) + 1);
+        
+        const MRH_Sint16* p_Segment;
+        size_t us_Elements;
+        size_t us_Chunk;
+        
+        for (size_t i = 0; i < c_Input.GetSegmentCount(); ++i)
+        {
+            p_Segment = c_Input.GetSegment(i, us_Elements);
+            
+            while (us_Elements > 0)
+            {
+                us_Chunk = us_FrameSize - us_Fill;
+                
+                if (us_Chunk > us_Elements)
+                {
+                    us_Chunk = us_Elements;
+                }
+                
+                u16_ChunkPeak = GetPeak(p_Segment, us_Chunk);
+                u16_Peak = u16_ChunkPeak > u16_Peak ? u16_ChunkPeak : u16_Peak;
+                
+                p_Segment += us_Chunk;
+                us_Elements -= us_Chunk;
+                us_Fill += us_Chunk;
+                
+                if (us_Fill == us_FrameSize)
+                {
+                    v_Silent.push_back(u16_Peak < u16_Threshold);
+                    u16_Peak = 0;
+                    us_Fill = 0;
+                }
+            }
+        }
+        
+        if (us_Fill > 0)
+        {
+            v_Silent.push_back(u16_Peak < u16_Threshold);
+        }
+    }
+    catch (std::exception& e)
+    {
+        throw Exception("Failed to trim audio: " + std::string(e.what()));
+    }
+    
+    /**
+     *  Trim
+     */
+    
+    size_t us_Frames = v_Silent.size();
+    size_t us_First = 0;
+    size_t us_Last = us_Frames;
+    
+    while (us_First < us_Frames && v_Silent[us_First] == true)
+    {
+        ++us_First;
+    }
+    
+    if (us_First == us_Frames)
+    {
+        // Only silence
+        return;
+    }
+    
+    while (v_Silent[us_Last - 1] == true)
+    {
+        --us_Last;
+    }
+    
+    // Keep padding around the audio
+    size_t us_Start = us_First > u32_PaddingFrames ? us_First - u32_PaddingFrames : 0;
+    size_t us_End = (us_Frames - us_Last) > u32_PaddingFrames ? us_Last + u32_PaddingFrames : us_Frames;
+    
+    /**
+     *  Compact
+     */
+    
+    // @NOTE: Long pauses keep their start and end, the middle is removed
+    size_t us_RangeStart = us_Start;
+    size_t us_Pause;
+    
+    for (size_t i = us_First; i < us_Last && u32_MaxPauseFrames > 0;)
+    {
+        if (v_Silent[i] == false)
+        {
+            ++i;
+            continue;
+        }
+        
+        us_Pause = i;
+        
+        while (v_Silent[i] == true)
+        {
+            ++i;
+        }
+        
+        if ((i - us_Pause) > u32_MaxPauseFrames)
+        {
+            size_t us_Cut = us_Pause + (u32_MaxPauseFrames / 2);
+            
+            c_Output.AddAudio(c_Input, us_RangeStart * us_FrameSize, (us_Cut - us_RangeStart) * us_FrameSize);
+            us_RangeStart = i - (u32_MaxPauseFrames - (u32_MaxPauseFrames / 2));
+        }
+    }
+    
+    // Last range, the final frame might be partial
+    size_t us_EndSample = us_End * us_FrameSize;
+    
+    if (us_EndSample > us_Total)
+    {
+        us_EndSample = us_Total;
+    }
+    
+    c_Output.AddAudio(c_Input, us_RangeStart * us_FrameSize, us_EndSample - (us_RangeStart * us_FrameSize));
+}
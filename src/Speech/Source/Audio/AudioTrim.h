@@ -0,0 +1,82 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#ifndef AudioTrim_h
+#define AudioTrim_h
+
+// C / C++
+
+// External
+#include <MRH_Typedefs.h>
+
+// Project
+#include "./AudioBuffer.h"
+
+
+class AudioTrim
+{
+public:
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     *
+     *  \param u32_Threshold The peak amplitude below which audio is silent.
+     *  \param u32_PaddingMS The silence in milliseconds kept before and after audio.
+     *  \param u32_MaxPauseMS The longest silence in milliseconds kept inside audio, 0 
+     *                        to keep all.
+     */
+    
+    AudioTrim(MRH_Uint32 u32_Threshold, MRH_Uint32 u32_PaddingMS, MRH_Uint32 u32_MaxPauseMS) noexcept;
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~AudioTrim() noexcept;
+    
+    //*************************************************************************************
+    // Process
+    //*************************************************************************************
+    
+    /**
+     *  Remove leading and trailing silence and shorten long pauses. This 
+     *  function is thread safe.
+     *
+     *  \param c_Input The audio to trim.
+     *  \param c_Output The trimmed audio. The audio buffer is replaced and 
+     *                  empty if the input was silent.
+     */
+    
+    void Process(AudioBuffer const& c_Input, AudioBuffer& c_Output) const;
+    
+private:
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    MRH_Uint16 u16_Threshold;
+    MRH_Uint32 u32_PaddingFrames;
+    MRH_Uint32 u32_MaxPauseFrames;
+    
+protected:
+    
+};
+
+#endif /* AudioTrim_h */
@@ -0,0 +1,285 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <cmath>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// External
+
+// Project
+#include "./EchoCanceller.h"
+
+// Pre-defined
+#ifndef MRH_SPEECH_ECHO_STEP_SIZE
+    #define MRH_SPEECH_ECHO_STEP_SIZE 0.5f
+#endif
+#ifndef MRH_SPEECH_ECHO_REGULARIZATION
+    #define MRH_SPEECH_ECHO_REGULARIZATION 100.0 // Per tap, about -50 dBFS
+#endif
+#ifndef MRH_SPEECH_ECHO_DOUBLE_TALK
+    #define MRH_SPEECH_ECHO_DOUBLE_TALK 0.5f // Geigel threshold
+#endif
+#ifndef MRH_SPEECH_ECHO_REFERENCE_MS
+    #define MRH_SPEECH_ECHO_REFERENCE_MS 5000
+#endif
+
+
+namespace
+{
+    //*************************************************************************************
+    // Filter
+    //*************************************************************************************
+    
+    float GetDot(const float* p_A, const float* p_B, size_t us_Elements) noexcept
+    {
+        size_t i = 0;
+        float f_Result = 0.f;
+        
+#if defined(__AVX2__)
+        __m256 c_Sum = _mm256_setzero_ps();
+        
+        for (; (i + 8) <= us_Elements; i += 8)
+        {
+#if defined(__FMA__)
+            c_Sum = _mm256_fmadd_ps(_mm256_loadu_ps(p_A + i), _mm256_loadu_ps(p_B + i), c_Sum);
+#else
+            c_Sum = _mm256_add_ps(c_Sum, _mm256_mul_ps(_mm256_loadu_ps(p_A + i), _mm256_loadu_ps(p_B + i)));
+#endif
+        }
+        
+        alignas(32) float p_Lane[8];
+        _mm256_store_ps(p_Lane, c_Sum);
+        
+        for (size_t j = 0; j < 8; ++j)
+        {
+            f_Result += p_Lane[j];
+        }
+#elif defined(__ARM_NEON)
+        float32x4_t c_Sum = vdupq_n_f32(0.f);
+        
+        for (; (i + 4) <= us_Elements; i += 4)
+        {
+            c_Sum = vmlaq_f32(c_Sum, vld1q_f32(p_A + i), vld1q_f32(p_B + i));
+        }
+        
+        float p_Lane[4];
+        vst1q_f32(p_Lane, c_Sum);
+        
+        for (size_t j = 0; j < 4; ++j)
+        {
+            f_Result += p_Lane[j];
+        }
+#endif
+        
+        // Remaining elements
+        for (; i < us_Elements; ++i)
+        {
+            f_Result += p_A[i] * p_B[i];
+        }
+        
+        return f_Result;
+    }
+    
+    void AddScaled(float* p_Target, const float* p_Source, float f_Scale, size_t us_Elements) noexcept
+    {
+        size_t i = 0;
+        
+#if defined(__AVX2__)
+        __m256 c_Scale = _mm256_set1_ps(f_Scale);
+        
+        for (; (i + 8) <= us_Elements; i += 8)
+        {
+#if defined(__FMA__)
+            _mm256_storeu_ps(p_Target + i, _mm256_fmadd_ps(_mm256_loadu_ps(p_Source + i), c_Scale, _mm256_loadu_ps(p_Target + i)));
+#else
+            _mm256_storeu_ps(p_Target + i, _mm256_add_ps(_mm256_loadu_ps(p_Target + i), _mm256_mul_ps(_mm256_loadu_ps(p_Source + i), c_Scale)));
+#endif
+        }
+#elif defined(__ARM_NEON)
+        float32x4_t c_Scale = vdupq_n_f32(f_Scale);
+        
+        for (; (i + 4) <= us_Elements; i += 4)
+        {
+            vst1q_f32(p_Target + i, vmlaq_f32(vld1q_f32(p_Target + i), vld1q_f32(p_Source + i), c_Scale));
+        }
+#endif
+        
+        // Remaining elements
+        for (; i < us_Elements; ++i)
+        {
+            p_Target[i] += p_Source[i] * f_Scale;
+        }
+    }
+}
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+EchoCanceller::EchoCanceller(MRH_Uint32 u32_KHz, MRH_Uint32 u32_FilterMS, MRH_Uint32 u32_DelayMS) : us_Taps((static_cast<size_t>(u32_KHz) * u32_FilterMS) / 1000),
+                                                                                                     us_HistoryPos(0),
+                                                                                                     d_Energy(0.0),
+                                                                                                     f_Peak(0.f),
+                                                                                                     us_Silent(0),
+                                                                                                     us_Delay((static_cast<size_t>(u32_KHz) * u32_DelayMS) / 1000),
+                                                                                                     us_MaxReference((static_cast<size_t>(u32_KHz) * MRH_SPEECH_ECHO_REFERENCE_MS) / 1000),
+                                                                                                     us_ReferenceRead(0)
+{
+    if (us_Taps == 0)
+    {
+        us_Taps = 1;
+    }
+    
+    us_Silent = us_Taps;
+    
+    try
+    {
+        v_Weight.resize(us_Taps, 0.f);
+        v_History.resize(us_Taps * 2, 0.f);
+    }
+    catch (std::exception& e)
+    {
+        throw Exception("Failed to create echo filter: " + std::string(e.what()));
+    }
+}
+
+EchoCanceller::~EchoCanceller() noexcept
+{}
+
+//*************************************************************************************
+// Reference
+//*************************************************************************************
+
+void EchoCanceller::AddReference(const MRH_Sint16* p_Buffer, size_t us_Elements)
+{
+    try
+    {
+        // Playback starts after the output delay
+        if (us_ReferenceRead == v_Reference.size())
+        {
+            v_Reference.assign(us_Delay, 0);
+            us_ReferenceRead = 0;
+        }
+        else if (us_ReferenceRead > us_MaxReference)
+        {
+            v_Reference.erase(v_Reference.begin(), v_Reference.begin() + us_ReferenceRead);
+            us_ReferenceRead = 0;
+        }
+        
+        v_Reference.insert(v_Reference.end(), p_Buffer, p_Buffer + us_Elements);
+    }
+    catch (std::exception& e)
+    {
+        throw Exception("Failed to add echo reference: " + std::string(e.what()));
+    }
+    
+    // @NOTE: Reference audio is only consumed while recording, drop 
+    //        the oldest audio if recording stopped
+    if ((v_Reference.size() - us_ReferenceRead) > us_MaxReference)
+    {
+        us_ReferenceRead = v_Reference.size() - us_MaxReference;
+    }
+}
+
+void EchoCanceller::ClearReference() noexcept
+{
+    v_Reference.clear();
+    us_ReferenceRead = 0;
+}
+
+//*************************************************************************************
+// Process
+//*************************************************************************************
+
+void EchoCanceller::Process(MRH_Sint16* p_Buffer, size_t us_Elements) noexcept
+{
+    const float f_PeakDecay = 1.f - (1.f / us_Taps);
+    float* p_History = v_History.data();
+    float* p_Weight = v_Weight.data();
+    float f_Reference;
+    float f_Old;
+    float f_Error;
+    
+    for (size_t i = 0; i < us_Elements; ++i)
+    {
+        // Next played sample, silence if nothing is played
+        if (us_ReferenceRead < v_Reference.size())
+        {
+            f_Reference = static_cast<float>(v_Reference[us_ReferenceRead]);
+            ++us_ReferenceRead;
+        }
+        else
+        {
+            f_Reference = 0.f;
+        }
+        
+        // @NOTE: Filter nothing while the whole history is silent
+        if (f_Reference != 0.f)
+        {
+            us_Silent = 0;
+        }
+        else if (us_Silent < us_Taps)
+        {
+            ++us_Silent;
+        }
+        else
+        {
+            continue;
+        }
+        
+        // Replace the oldest sample, the window starts after the newest
+        // @NOTE: Samples are integers, the energy stays exact in double
+        f_Old = p_History[us_HistoryPos];
+        d_Energy += static_cast<double>(f_Reference) * f_Reference - static_cast<double>(f_Old) * f_Old;
+        
+        p_History[us_HistoryPos] = f_Reference;
+        p_History[us_HistoryPos + us_Taps] = f_Reference;
+        us_HistoryPos = (us_HistoryPos + 1) % us_Taps;
+        
+        const float* p_Window = p_History + us_HistoryPos;
+        
+        f_Peak = std::fabs(f_Reference) > f_Peak ? std::fabs(f_Reference) : f_Peak * f_PeakDecay;
+        f_Error = static_cast<float>(p_Buffer[i]) - GetDot(p_Weight, p_Window, us_Taps);
+        
+        // Adapt without near end speech
+        if (std::fabs(static_cast<float>(p_Buffer[i])) < f_Peak * MRH_SPEECH_ECHO_DOUBLE_TALK)
+        {
+            AddScaled(p_Weight, 
+                      p_Window, 
+                      static_cast<float>((MRH_SPEECH_ECHO_STEP_SIZE * f_Error) / (d_Energy + MRH_SPEECH_ECHO_REGULARIZATION * us_Taps)), 
+                      us_Taps);
+        }
+        
+        if (f_Error > 32767.f)
+        {
+            p_Buffer[i] = 32767;
+        }
+        else if (f_Error < -32768.f)
+        {
+            p_Buffer[i] = -32768;
+        }
+        else
+        {
+            p_Buffer[i] = static_cast<MRH_Sint16>(std::lrint(f_Error));
+        }
+    }
+}
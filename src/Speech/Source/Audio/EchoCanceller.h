@@ -0,0 +1,112 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef EchoCanceller_h
+#define EchoCanceller_h
+
+// C / C++
+#include <vector>
+
+// External
+#include <MRH_Typedefs.h>
+
+// Project
+#include "../../../Exception.h"
+
+
+class EchoCanceller
+{
+public:
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     *
+     *  \param u32_KHz The KHz of the recorded and reference audio.
+     *  \param u32_FilterMS The echo length in milliseconds covered by the filter.
+     *  \param u32_DelayMS The delay in milliseconds between sent and recorded playback.
+     */
+    
+    EchoCanceller(MRH_Uint32 u32_KHz, MRH_Uint32 u32_FilterMS, MRH_Uint32 u32_DelayMS);
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~EchoCanceller() noexcept;
+    
+    //*************************************************************************************
+    // Reference
+    //*************************************************************************************
+    
+    /**
+     *  Add sent playback audio. Reference audio is consumed at the rate audio 
+     *  is recorded.
+     *
+     *  \param p_Buffer The audio buffer.
+     *  \param us_Elements The elements in the audio buffer.
+     */
+    
+    void AddReference(const MRH_Sint16* p_Buffer, size_t us_Elements);
+    
+    /**
+     *  Discard all reference audio which was not yet recorded.
+     */
+    
+    void ClearReference() noexcept;
+    
+    //*************************************************************************************
+    // Process
+    //*************************************************************************************
+    
+    /**
+     *  Remove the playback echo from recorded audio.
+     *
+     *  \param p_Buffer The recorded audio buffer. The buffer is replaced.
+     *  \param us_Elements The elements in the audio buffer.
+     */
+    
+    void Process(MRH_Sint16* p_Buffer, size_t us_Elements) noexcept;
+    
+private:
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    // Filter
+    size_t us_Taps;
+    std::vector<float> v_Weight;
+    std::vector<float> v_History; // Mirrored, each window is contiguous
+    size_t us_HistoryPos;
+    double d_Energy;
+    float f_Peak;
+    size_t us_Silent; // Samples since the last reference audio
+    
+    // Reference
+    size_t us_Delay;
+    size_t us_MaxReference;
+    std::vector<MRH_Sint16> v_Reference;
+    size_t us_ReferenceRead;
+    
+protected:
+    
+};
+
+#endif /* EchoCanceller_h */
@@ -0,0 +1,864 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+// C / C++
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <cerrno>
+#include <cstring>
+#include <cstdlib>
+
+// External
+#include <libmrhpsb/MRH_PSBLogger.h>
+
+// Project
+#include "./PhraseStore.h"
+#include "../../../Metrics.h"
+
+// Pre-defined
+#ifndef MRH_SPEECH_PHRASE_STORE_MAX_PENDING
+    #define MRH_SPEECH_PHRASE_STORE_MAX_PENDING 16
+#endif
+#define PHRASE_STORE_INDEX_FILE "Phrases.idx"
+#define PHRASE_STORE_INDEX_TEMP_FILE "Phrases.idx.tmp"
+#define PHRASE_STORE_DATA_FILE_PREFIX "Phrases."
+#define PHRASE_STORE_DATA_FILE_SUFFIX ".dat"
+#define PHRASE_STORE_INDEX_VERSION 1
+#define PHRASE_STORE_RECORD_MAGIC 0x53524850 // PHRS
+
+
+namespace
+{
+    //*************************************************************************************
+    // Layout
+    //*************************************************************************************
+    
+    // @NOTE: The data file is a sequence of records, each record is 
+    //        the header followed by the key and the samples
+    struct RecordHeader
+    {
+        MRH_Uint32 u32_Magic;
+        MRH_Uint32 u32_KeySize;
+        MRH_Uint32 u32_KHz;
+        MRH_Uint32 u32_Samples;
+    };
+    
+    // @NOTE: The index is the header followed by the record entries, 
+    //        most recently used first
+    struct IndexHeader
+    {
+        char p_Magic[8];
+        MRH_Uint32 u32_Version;
+        MRH_Uint32 u32_Generation;
+        MRH_Uint32 u32_Count;
+        MRH_Uint32 u32_Reserved;
+        MRH_Uint64 u64_Checksum; // Entries
+    };
+    
+    struct IndexEntry
+    {
+        MRH_Uint64 u64_Offset;
+        MRH_Uint32 u32_Size;
+        MRH_Uint32 u32_Reserved;
+    };
+    
+    const char p_IndexMagic[8] = { 'M', 'R', 'H', 'P', 'S', 'I', 'D', 'X' };
+    
+    inline size_t Align(size_t us_Bytes) noexcept
+    {
+        // Samples stay aligned in the mapped file
+        return (us_Bytes + 7) & ~static_cast<size_t>(7);
+    }
+    
+    inline size_t GetRecordSize(size_t us_KeySize, size_t us_Samples) noexcept
+    {
+        return sizeof(RecordHeader) + Align(us_KeySize) + Align(us_Samples * sizeof(MRH_Sint16));
+    }
+    
+    /**
+     *  Create a FNV-1a checksum.
+     *  
+     *  \param p_Buffer The bytes to check.
+     *  \param us_Size The byte count.
+     *  
+     *  \return The checksum.
+     */
+    
+    MRH_Uint64 GetChecksum(const void* p_Buffer, size_t us_Size) noexcept
+    {
+        const MRH_Uint8* p_Byte = static_cast<const MRH_Uint8*>(p_Buffer);
+        MRH_Uint64 u64_Hash = 14695981039346656037ULL;
+        
+        for (size_t i = 0; i < us_Size; ++i)
+        {
+            u64_Hash ^= p_Byte[i];
+            u64_Hash *= 1099511628211ULL;
+        }
+        
+        return u64_Hash;
+    }
+    
+    //*************************************************************************************
+    // File
+    //*************************************************************************************
+    
+    /**
+     *  Write all bytes to a file.
+     *  
+     *  \param i_FD The file descriptor.
+     *  \param p_Buffer The bytes to write.
+     *  \param us_Size The byte count.
+     *  \param u64_Offset The file offset to write to.
+     */
+    
+    void Write(int i_FD, const void* p_Buffer, size_t us_Size, MRH_Uint64 u64_Offset)
+    {
+        const MRH_Uint8* p_Byte = static_cast<const MRH_Uint8*>(p_Buffer);
+        ssize_t ss_Written;
+        
+        while (us_Size > 0)
+        {
+            if ((ss_Written = pwrite(i_FD, p_Byte, us_Size, static_cast<off_t>(u64_Offset))) < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                
+                throw Exception("Failed to write phrase store file: " + std::string(std::strerror(errno)));
+            }
+            
+            p_Byte += ss_Written;
+            us_Size -= static_cast<size_t>(ss_Written);
+            u64_Offset += static_cast<MRH_Uint64>(ss_Written);
+        }
+    }
+    
+    /**
+     *  Read all bytes from a file.
+     *  
+     *  \param i_FD The file descriptor.
+     *  \param p_Buffer The buffer to read to.
+     *  \param us_Size The byte count.
+     *  \param u64_Offset The file offset to read from.
+     *  
+     *  \return true if all bytes were read, false if not.
+     */
+    
+    bool Read(int i_FD, void* p_Buffer, size_t us_Size, MRH_Uint64 u64_Offset) noexcept
+    {
+        MRH_Uint8* p_Byte = static_cast<MRH_Uint8*>(p_Buffer);
+        ssize_t ss_Read;
+        
+        while (us_Size > 0)
+        {
+            if ((ss_Read = pread(i_FD, p_Byte, us_Size, static_cast<off_t>(u64_Offset))) <= 0)
+            {
+                if (ss_Read < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                
+                return false;
+            }
+            
+            p_Byte += ss_Read;
+            us_Size -= static_cast<size_t>(ss_Read);
+            u64_Offset += static_cast<MRH_Uint64>(ss_Read);
+        }
+        
+        return true;
+    }
+    
+    /**
+     *  Flush a directory, making renamed and created files durable.
+     *  
+     *  \param s_DirectoryPath The directory to flush.
+     */
+    
+    void SyncDirectory(std::string const& s_DirectoryPath)
+    {
+        int i_FD = open(s_DirectoryPath.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        
+        if (i_FD < 0 || fsync(i_FD) < 0)
+        {
+            int i_Error = errno;
+            
+            if (i_FD >= 0)
+            {
+                close(i_FD);
+            }
+            
+            throw Exception("Failed to sync phrase store directory: " + std::string(std::strerror(i_Error)));
+        }
+        
+        close(i_FD);
+    }
+}
+
+//*************************************************************************************
+// Mapping
+//*************************************************************************************
+
+class PhraseStore::Mapping
+{
+public:
+    
+    /**
+     *  Default constructor.
+     *
+     *  \param i_FD The file to map.
+     *  \param us_Size The bytes to map.
+     */
+    
+    Mapping(int i_FD, size_t us_Size) : us_Size(us_Size)
+    {
+        void* p_Map = mmap(NULL, us_Size, PROT_READ, MAP_SHARED, i_FD, 0);
+        
+        if (p_Map == MAP_FAILED)
+        {
+            throw Exception("Failed to map phrase store file: " + std::string(std::strerror(errno)));
+        }
+        
+        p_Data = static_cast<const MRH_Uint8*>(p_Map);
+    }
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~Mapping() noexcept
+    {
+        munmap(const_cast<MRH_Uint8*>(p_Data), us_Size);
+    }
+    
+    /**
+     *  Get a validated record.
+     *
+     *  \param u64_Offset The record offset.
+     *  \param u32_Size The record size.
+     *
+     *  \return The record header, NULL if invalid.
+     */
+    
+    const RecordHeader* GetRecord(MRH_Uint64 u64_Offset, MRH_Uint32 u32_Size) const noexcept
+    {
+        if (u64_Offset + sizeof(RecordHeader) > us_Size || u64_Offset + u32_Size > us_Size)
+        {
+            return NULL;
+        }
+        
+        const RecordHeader* p_Header = reinterpret_cast<const RecordHeader*>(p_Data + u64_Offset);
+        
+        if (p_Header->u32_Magic != PHRASE_STORE_RECORD_MAGIC ||
+            GetRecordSize(p_Header->u32_KeySize, p_Header->u32_Samples) != u32_Size)
+        {
+            return NULL;
+        }
+        
+        return p_Header;
+    }
+    
+    const MRH_Uint8* p_Data;
+    size_t us_Size;
+};
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+PhraseStore::PhraseStore(std::string const& s_DirectoryPath, size_t us_MaxBytes) : b_Update(true),
+                                                                                   i_FD(-1),
+                                                                                   u32_Generation(0),
+                                                                                   u64_FileSize(0),
+                                                                                   u64_LiveBytes(0),
+                                                                                   s_DirectoryPath(s_DirectoryPath),
+                                                                                   us_MaxBytes(us_MaxBytes),
+                                                                                   b_Enabled(false)
+{
+    if (s_DirectoryPath.size() == 0 || us_MaxBytes == 0)
+    {
+        return;
+    }
+    
+    // @NOTE: No crashing, phrases are synthesised without the store
+    try
+    {
+        Open();
+    }
+    catch (std::exception& e)
+    {
+        MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::ERROR, "Phrase store disabled: " + std::string(e.what()),
+                                       "PhraseStore.cpp", __LINE__);
+        
+        if (i_FD >= 0)
+        {
+            close(i_FD);
+            i_FD = -1;
+        }
+        
+        l_Entry.clear();
+        m_Entry.clear();
+        p_Mapping.reset();
+        
+        return;
+    }
+    
+    try
+    {
+        c_Thread = std::thread(Update, this);
+    }
+    catch (std::exception& e)
+    {
+        close(i_FD);
+        throw Exception("Failed to start phrase store thread: " + std::string(e.what()));
+    }
+    
+    b_Enabled = true;
+}
+
+PhraseStore::~PhraseStore() noexcept
+{
+    if (c_Thread.joinable() == true)
+    {
+        // @NOTE: Phrases not yet written are dropped, the index 
+        //        always matches the written data
+        {
+            std::lock_guard<std::mutex> c_Guard(c_Mutex);
+            
+            dq_Job.clear();
+            b_Update = false;
+        }
+        
+        c_Condition.notify_all();
+        c_Thread.join();
+    }
+    
+    if (i_FD >= 0)
+    {
+        close(i_FD);
+    }
+}
+
+//*************************************************************************************
+// Update
+//*************************************************************************************
+
+void PhraseStore::Update(PhraseStore* p_Instance) noexcept
+{
+    while (true)
+    {
+        std::unique_lock<std::mutex> c_Lock(p_Instance->c_Mutex);
+        
+        p_Instance->c_Condition.wait(c_Lock, [p_Instance]()
+        {
+            return p_Instance->dq_Job.size() > 0 || p_Instance->b_Update == false;
+        });
+        
+        if (p_Instance->b_Update == false)
+        {
+            return;
+        }
+        
+        Job c_Job(std::move(p_Instance->dq_Job.front()));
+        p_Instance->dq_Job.pop_front();
+        
+        // @NOTE: Disk writes never block readers
+        c_Lock.unlock();
+        
+        try
+        {
+            p_Instance->Append(c_Job);
+        }
+        catch (std::exception& e)
+        {
+            MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::ERROR, e.what(),
+                                           "PhraseStore.cpp", __LINE__);
+        }
+    }
+}
+
+//*************************************************************************************
+// Open
+//*************************************************************************************
+
+void PhraseStore::Open()
+{
+    if (mkdir(s_DirectoryPath.c_str(), 0755) < 0 && errno != EEXIST)
+    {
+        throw Exception("Failed to create phrase store directory: " + std::string(std::strerror(errno)));
+    }
+    
+    /**
+     *  Index
+     */
+    
+    std::string s_IndexPath = s_DirectoryPath + "/" + PHRASE_STORE_INDEX_FILE;
+    std::vector<IndexEntry> v_Index;
+    IndexHeader c_Header;
+    bool b_Valid = false;
+    int i_IndexFD = open(s_IndexPath.c_str(), O_RDONLY | O_CLOEXEC);
+    
+    if (i_IndexFD >= 0)
+    {
+        if (Read(i_IndexFD, &c_Header, sizeof(c_Header), 0) == true &&
+            std::memcmp(c_Header.p_Magic, p_IndexMagic, sizeof(p_IndexMagic)) == 0 &&
+            c_Header.u32_Version == PHRASE_STORE_INDEX_VERSION)
+        {
+            try
+            {
+                v_Index.resize(c_Header.u32_Count);
+                
+                b_Valid = Read(i_IndexFD, v_Index.data(), v_Index.size() * sizeof(IndexEntry), sizeof(c_Header)) &&
+                          GetChecksum(v_Index.data(), v_Index.size() * sizeof(IndexEntry)) == c_Header.u64_Checksum;
+            }
+            catch (...)
+            {}
+        }
+        
+        close(i_IndexFD);
+    }
+    
+    if (b_Valid == true)
+    {
+        u32_Generation = c_Header.u32_Generation;
+    }
+    else
+    {
+        // Start a new store, a unreadable index is never trusted
+        v_Index.clear();
+        u32_Generation = 0;
+    }
+    
+    /**
+     *  Data
+     */
+    
+    std::string s_DataPath = GetDataFilePath(u32_Generation);
+    struct stat c_Stat;
+    
+    if ((i_FD = open(s_DataPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC | (b_Valid == true ? 0 : O_TRUNC), 0644)) < 0 ||
+        fstat(i_FD, &c_Stat) < 0)
+    {
+        throw Exception("Failed to open phrase store data file: " + std::string(std::strerror(errno)));
+    }
+    
+    u64_FileSize = static_cast<MRH_Uint64>(c_Stat.st_size);
+    
+    if (u64_FileSize > 0)
+    {
+        p_Mapping = std::make_shared<Mapping>(i_FD, u64_FileSize);
+    }
+    
+    // Load committed phrases, records past the index are unused
+    const RecordHeader* p_Record;
+    
+    for (auto& Index : v_Index)
+    {
+        if (!p_Mapping || (p_Record = p_Mapping->GetRecord(Index.u64_Offset, Index.u32_Size)) == NULL)
+        {
+            MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::WARNING, "Invalid phrase store record at " + std::to_string(Index.u64_Offset) + "!",
+                                           "PhraseStore.cpp", __LINE__);
+            continue;
+        }
+        
+        std::string s_Key(reinterpret_cast<const char*>(p_Record + 1), p_Record->u32_KeySize);
+        
+        if (m_Entry.find(s_Key) != m_Entry.end())
+        {
+            continue;
+        }
+        
+        // Keep within the limit, the limit might have changed
+        if (u64_LiveBytes + Index.u32_Size > us_MaxBytes)
+        {
+            break;
+        }
+        
+        l_Entry.push_back({ s_Key, Index.u64_Offset, Index.u32_Size, p_Record->u32_KHz, p_Record->u32_Samples });
+        m_Entry.emplace(s_Key, std::prev(l_Entry.end()));
+        
+        u64_LiveBytes += Index.u32_Size;
+    }
+    
+    if (b_Valid == false || l_Entry.size() != v_Index.size())
+    {
+        WriteIndex(u32_Generation, l_Entry);
+    }
+    
+    /**
+     *  Cleanup
+     */
+    
+    // Data files of other generations were left by a interrupted compaction
+    DIR* p_Dir = opendir(s_DirectoryPath.c_str());
+    
+    if (p_Dir != NULL)
+    {
+        std::string s_Current = s_DataPath.substr(s_DataPath.find_last_of('/') + 1);
+        std::string s_Name;
+        struct dirent* p_Entry;
+        
+        while ((p_Entry = readdir(p_Dir)) != NULL)
+        {
+            s_Name = p_Entry->d_name;
+            
+            if (s_Name.compare(0, std::strlen(PHRASE_STORE_DATA_FILE_PREFIX), PHRASE_STORE_DATA_FILE_PREFIX) == 0 &&
+                s_Name.size() > std::strlen(PHRASE_STORE_DATA_FILE_SUFFIX) &&
+                s_Name.compare(s_Name.size() - std::strlen(PHRASE_STORE_DATA_FILE_SUFFIX), std::string::npos, PHRASE_STORE_DATA_FILE_SUFFIX) == 0 &&
+                s_Name != s_Current)
+            {
+                unlink((s_DirectoryPath + "/" + s_Name).c_str());
+            }
+        }
+        
+        closedir(p_Dir);
+    }
+}
+
+//*************************************************************************************
+// Write
+//*************************************************************************************
+
+void PhraseStore::Append(Job const& c_Job)
+{
+    size_t us_Record = GetRecordSize(c_Job.s_Key.size(), c_Job.v_Samples.size());
+    
+    if (us_Record > us_MaxBytes || us_Record > 0xFFFFFFFF)
+    {
+        return;
+    }
+    
+    // Remove least recently used until the phrase fits
+    {
+        std::lock_guard<std::mutex> c_Guard(c_Mutex);
+        
+        if (m_Entry.find(c_Job.s_Key) != m_Entry.end())
+        {
+            return;
+        }
+        
+        while (u64_LiveBytes + us_Record > us_MaxBytes && l_Entry.size() > 0)
+        {
+            u64_LiveBytes -= l_Entry.back().u32_Size;
+            m_Entry.erase(l_Entry.back().s_Key);
+            l_Entry.pop_back();
+            
+            Metrics::Singleton().Add(Metrics::PHRASE_STORE_EVICTED);
+        }
+    }
+    
+    // Removed phrases stay in the data file, compact once 
+    // the data file exceeds the limit
+    if (u64_FileSize + us_Record > us_MaxBytes + (us_MaxBytes / 2))
+    {
+        Compact();
+    }
+    
+    /**
+     *  Append
+     */
+    
+    std::vector<MRH_Uint8> v_Record(us_Record, 0);
+    RecordHeader* p_Header = reinterpret_cast<RecordHeader*>(v_Record.data());
+    
+    p_Header->u32_Magic = PHRASE_STORE_RECORD_MAGIC;
+    p_Header->u32_KeySize = static_cast<MRH_Uint32>(c_Job.s_Key.size());
+    p_Header->u32_KHz = c_Job.u32_KHz;
+    p_Header->u32_Samples = static_cast<MRH_Uint32>(c_Job.v_Samples.size());
+    
+    std::memcpy(v_Record.data() + sizeof(RecordHeader), c_Job.s_Key.data(), c_Job.s_Key.size());
+    std::memcpy(v_Record.data() + sizeof(RecordHeader) + Align(c_Job.s_Key.size()), c_Job.v_Samples.data(), c_Job.v_Samples.size() * sizeof(MRH_Sint16));
+    
+    // @NOTE: The record has to be durable before the index references it
+    Write(i_FD, v_Record.data(), us_Record, u64_FileSize);
+    
+    if (fdatasync(i_FD) < 0)
+    {
+        throw Exception("Failed to sync phrase store data file: " + std::string(std::strerror(errno)));
+    }
+    
+    // Readers keep the previous mapping until their phrase was played
+    std::shared_ptr<Mapping> p_Next = std::make_shared<Mapping>(i_FD, u64_FileSize + us_Record);
+    std::list<Entry> l_Commit;
+    
+    {
+        std::lock_guard<std::mutex> c_Guard(c_Mutex);
+        
+        l_Entry.push_front({ c_Job.s_Key, u64_FileSize, static_cast<MRH_Uint32>(us_Record), c_Job.u32_KHz, static_cast<MRH_Uint32>(c_Job.v_Samples.size()) });
+        
+        try
+        {
+            m_Entry.emplace(c_Job.s_Key, l_Entry.begin());
+        }
+        catch (...)
+        {
+            l_Entry.pop_front();
+            throw;
+        }
+        
+        p_Mapping = p_Next;
+        u64_FileSize += us_Record;
+        u64_LiveBytes += us_Record;
+        
+        l_Commit = l_Entry;
+    }
+    
+    WriteIndex(u32_Generation, l_Commit);
+}
+
+void PhraseStore::Compact()
+{
+    std::list<Entry> l_Commit;
+    std::shared_ptr<Mapping> p_Current;
+    
+    {
+        std::lock_guard<std::mutex> c_Guard(c_Mutex);
+        
+        l_Commit = l_Entry;
+        p_Current = p_Mapping;
+    }
+    
+    /**
+     *  Copy
+     */
+    
+    MRH_Uint32 u32_Next = u32_Generation + 1;
+    std::string s_NextPath = GetDataFilePath(u32_Next);
+    MRH_Uint64 u64_NextSize = 0;
+    int i_NextFD = open(s_NextPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    
+    if (i_NextFD < 0)
+    {
+        throw Exception("Failed to create phrase store data file: " + std::string(std::strerror(errno)));
+    }
+    
+    std::shared_ptr<Mapping> p_Next;
+    
+    try
+    {
+        for (auto& Commit : l_Commit)
+        {
+            Write(i_NextFD, p_Current->p_Data + Commit.u64_Offset, Commit.u32_Size, u64_NextSize);
+            
+            Commit.u64_Offset = u64_NextSize;
+            u64_NextSize += Commit.u32_Size;
+        }
+        
+        if (fdatasync(i_NextFD) < 0)
+        {
+            throw Exception("Failed to sync phrase store data file: " + std::string(std::strerror(errno)));
+        }
+        
+        if (u64_NextSize > 0)
+        {
+            p_Next = std::make_shared<Mapping>(i_NextFD, u64_NextSize);
+        }
+        
+        // @NOTE: Replacing the index switches to the new data file, 
+        //        a interrupted compaction keeps the previous one
+        WriteIndex(u32_Next, l_Commit);
+    }
+    catch (...)
+    {
+        close(i_NextFD);
+        unlink(s_NextPath.c_str());
+        throw;
+    }
+    
+    /**
+     *  Switch
+     */
+    
+    {
+        std::lock_guard<std::mutex> c_Guard(c_Mutex);
+        
+        // @NOTE: Only the store thread removes phrases, all are still known
+        for (auto& Commit : l_Commit)
+        {
+            m_Entry.find(Commit.s_Key)->second->u64_Offset = Commit.u64_Offset;
+        }
+        
+        p_Mapping = p_Next;
+    }
+    
+    close(i_FD);
+    unlink(GetDataFilePath(u32_Generation).c_str());
+    
+    i_FD = i_NextFD;
+    u32_Generation = u32_Next;
+    u64_FileSize = u64_NextSize;
+    
+    Metrics::Singleton().Add(Metrics::PHRASE_STORE_COMPACTION);
+}
+
+void PhraseStore::WriteIndex(MRH_Uint32 u32_Generation, std::list<Entry> const& l_Commit) const
+{
+    std::vector<IndexEntry> v_Index;
+    IndexHeader c_Header;
+    
+    v_Index.reserve(l_Commit.size());
+    
+    for (auto& Commit : l_Commit)
+    {
+        v_Index.push_back({ Commit.u64_Offset, Commit.u32_Size, 0 });
+    }
+    
+    std::memcpy(c_Header.p_Magic, p_IndexMagic, sizeof(p_IndexMagic));
+    c_Header.u32_Version = PHRASE_STORE_INDEX_VERSION;
+    c_Header.u32_Generation = u32_Generation;
+    c_Header.u32_Count = static_cast<MRH_Uint32>(v_Index.size());
+    c_Header.u32_Reserved = 0;
+    c_Header.u64_Checksum = GetChecksum(v_Index.data(), v_Index.size() * sizeof(IndexEntry));
+    
+    // Write a new index and replace the current one, the rename is the commit
+    std::string s_TempPath = s_DirectoryPath + "/" + PHRASE_STORE_INDEX_TEMP_FILE;
+    int i_IndexFD = open(s_TempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    
+    if (i_IndexFD < 0)
+    {
+        throw Exception("Failed to create phrase store index: " + std::string(std::strerror(errno)));
+    }
+    
+    try
+    {
+        Write(i_IndexFD, &c_Header, sizeof(c_Header), 0);
+        Write(i_IndexFD, v_Index.data(), v_Index.size() * sizeof(IndexEntry), sizeof(c_Header));
+        
+        if (fsync(i_IndexFD) < 0)
+        {
+            throw Exception("Failed to sync phrase store index: " + std::string(std::strerror(errno)));
+        }
+    }
+    catch (...)
+    {
+        close(i_IndexFD);
+        throw;
+    }
+    
+    close(i_IndexFD);
+    
+    if (rename(s_TempPath.c_str(), (s_DirectoryPath + "/" + PHRASE_STORE_INDEX_FILE).c_str()) < 0)
+    {
+        throw Exception("Failed to replace phrase store index: " + std::string(std::strerror(errno)));
+    }
+    
+    SyncDirectory(s_DirectoryPath);
+}
+
+//*************************************************************************************
+// Add
+//*************************************************************************************
+
+void PhraseStore::Add(std::string const& s_Key, AudioBuffer const& c_Audio) noexcept
+{
+    if (b_Enabled == false || c_Audio.GetSampleCount() == 0)
+    {
+        return;
+    }
+    
+    try
+    {
+        // Copy outside of the lock, the store thread writes later
+        Job c_Job;
+        const MRH_Sint16* p_Segment;
+        size_t us_Elements;
+        
+        c_Job.s_Key = s_Key;
+        c_Job.u32_KHz = c_Audio.GetKHz();
+        c_Job.v_Samples.reserve(c_Audio.GetSampleCount());
+        
+        for (size_t i = 0; i < c_Audio.GetSegmentCount(); ++i)
+        {
+            p_Segment = c_Audio.GetSegment(i, us_Elements);
+            c_Job.v_Samples.insert(c_Job.v_Samples.end(), p_Segment, p_Segment + us_Elements);
+        }
+        
+        std::lock_guard<std::mutex> c_Guard(c_Mutex);
+        
+        // Never queue more than the store thread can write
+        if (dq_Job.size() >= MRH_SPEECH_PHRASE_STORE_MAX_PENDING || m_Entry.find(s_Key) != m_Entry.end())
+        {
+            return;
+        }
+        
+        dq_Job.push_back(std::move(c_Job));
+        c_Condition.notify_one();
+    }
+    catch (std::exception& e)
+    {
+        MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::WARNING, "Failed to store phrase: " + std::string(e.what()),
+                                       "PhraseStore.cpp", __LINE__);
+    }
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+bool PhraseStore::GetPhrase(std::string const& s_Key, Phrase& c_Phrase) noexcept
+{
+    if (b_Enabled == false)
+    {
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+    
+    auto Entry = m_Entry.find(s_Key);
+    
+    if (Entry == m_Entry.end())
+    {
+        Metrics::Singleton().Add(Metrics::PHRASE_STORE_MISS);
+        return false;
+    }
+    
+    // Now most recently used, written with the next index
+    l_Entry.splice(l_Entry.begin(), l_Entry, Entry->second);
+    
+    const PhraseStore::Entry& c_Entry = *(Entry->second);
+    
+    c_Phrase.p_Source = p_Mapping;
+    c_Phrase.p_Samples = reinterpret_cast<const MRH_Sint16*>(p_Mapping->p_Data + c_Entry.u64_Offset + sizeof(RecordHeader) + Align(c_Entry.s_Key.size()));
+    c_Phrase.us_Samples = c_Entry.u32_Samples;
+    c_Phrase.u32_KHz = c_Entry.u32_KHz;
+    
+    Metrics::Singleton().Add(Metrics::PHRASE_STORE_HIT);
+    return true;
+}
+
+bool PhraseStore::GetStored(std::string const& s_Key) noexcept
+{
+    if (b_Enabled == false)
+    {
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> c_Guard(c_Mutex);
+    return m_Entry.find(s_Key) != m_Entry.end();
+}
+
+bool PhraseStore::GetEnabled() const noexcept
+{
+    return b_Enabled;
+}
+
+std::string PhraseStore::GetDataFilePath(MRH_Uint32 u32_Generation) const
+{
+    return s_DirectoryPath + "/" + PHRASE_STORE_DATA_FILE_PREFIX + std::to_string(u32_Generation) + PHRASE_STORE_DATA_FILE_SUFFIX;
+}
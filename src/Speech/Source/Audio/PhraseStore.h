@@ -0,0 +1,242 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#ifndef PhraseStore_h
+#define PhraseStore_h
+
+// C / C++
+#include <string>
+#include <vector>
+#include <list>
+#include <deque>
+#include <unordered_map>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// External
+#include <MRH_Typedefs.h>
+
+// Project
+#include "./AudioBuffer.h"
+
+
+class PhraseStore
+{
+public:
+    
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+    
+    struct Phrase
+    {
+        Phrase() noexcept : p_Samples(NULL),
+                            us_Samples(0),
+                            u32_KHz(0)
+        {}
+        
+        std::shared_ptr<const void> p_Source; // Keeps the samples mapped
+        const MRH_Sint16* p_Samples; // NULL if not set
+        size_t us_Samples;
+        MRH_Uint32 u32_KHz;
+    };
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor. The store is disabled if it could not be opened.
+     *
+     *  \param s_DirectoryPath The directory containing the store files, empty to disable.
+     *  \param us_MaxBytes The maximum bytes of stored phrases, 0 to disable.
+     */
+    
+    PhraseStore(std::string const& s_DirectoryPath, size_t us_MaxBytes);
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~PhraseStore() noexcept;
+    
+    //*************************************************************************************
+    // Add
+    //*************************************************************************************
+    
+    /**
+     *  Add audio to the store. The audio is written on the store thread, the 
+     *  least recently used phrases are removed if the store is full. This 
+     *  function is thread safe.
+     *
+     *  \param s_Key The key identifying the audio content.
+     *  \param c_Audio The audio to store.
+     */
+    
+    void Add(std::string const& s_Key, AudioBuffer const& c_Audio) noexcept;
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get a stored phrase. The phrase samples are read from the mapped store 
+     *  file without copying. This function is thread safe.
+     *
+     *  \param s_Key The key identifying the audio content.
+     *  \param c_Phrase The phrase to set.
+     *
+     *  \return true if the phrase was stored, false if not.
+     */
+    
+    bool GetPhrase(std::string const& s_Key, Phrase& c_Phrase) noexcept;
+    
+    /**
+     *  Check if a phrase is stored without using it. This function is thread safe.
+     *
+     *  \param s_Key The key identifying the audio content.
+     *
+     *  \return true if the phrase is stored, false if not.
+     */
+    
+    bool GetStored(std::string const& s_Key) noexcept;
+    
+    /**
+     *  Check if the store is used.
+     *
+     *  \return true if used, false if not.
+     */
+    
+    bool GetEnabled() const noexcept;
+    
+private:
+    
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+    
+    class Mapping;
+    
+    struct Entry
+    {
+        std::string s_Key;
+        MRH_Uint64 u64_Offset; // Record offset in the data file
+        MRH_Uint32 u32_Size; // Record bytes
+        MRH_Uint32 u32_KHz;
+        MRH_Uint32 u32_Samples;
+    };
+    
+    struct Job
+    {
+        std::string s_Key;
+        MRH_Uint32 u32_KHz;
+        std::vector<MRH_Sint16> v_Samples;
+    };
+    
+    //*************************************************************************************
+    // Update
+    //*************************************************************************************
+    
+    /**
+     *  Write added phrases.
+     *
+     *  \param p_Instance The store instance to update.
+     */
+    
+    static void Update(PhraseStore* p_Instance) noexcept;
+    
+    //*************************************************************************************
+    // Open
+    //*************************************************************************************
+    
+    /**
+     *  Open the store files. Phrases of the last committed index are loaded, 
+     *  files left by a interrupted write are removed.
+     */
+    
+    void Open();
+    
+    //*************************************************************************************
+    // Write
+    //*************************************************************************************
+    
+    /**
+     *  Append a phrase to the data file and commit it to the index.
+     *
+     *  \param c_Job The phrase to append.
+     */
+    
+    void Append(Job const& c_Job);
+    
+    /**
+     *  Copy all phrases to a new data file and commit it to the index.
+     */
+    
+    void Compact();
+    
+    /**
+     *  Replace the index with the current phrases.
+     *
+     *  \param u32_Generation The data file generation to commit.
+     *  \param l_Commit The phrases to commit, most recently used first.
+     */
+    
+    void WriteIndex(MRH_Uint32 u32_Generation, std::list<Entry> const& l_Commit) const;
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the data file path for a generation.
+     *
+     *  \param u32_Generation The data file generation.
+     *
+     *  \return The full data file path.
+     */
+    
+    std::string GetDataFilePath(MRH_Uint32 u32_Generation) const;
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    std::thread c_Thread;
+    std::mutex c_Mutex;
+    std::condition_variable c_Condition;
+    std::deque<Job> dq_Job;
+    bool b_Update;
+    
+    std::list<Entry> l_Entry; // Most recent first
+    std::unordered_map<std::string, std::list<Entry>::iterator> m_Entry;
+    std::shared_ptr<Mapping> p_Mapping;
+    
+    // @NOTE: Only changed by the store thread
+    int i_FD;
+    MRH_Uint32 u32_Generation;
+    MRH_Uint64 u64_FileSize;
+    MRH_Uint64 u64_LiveBytes;
+    
+    std::string s_DirectoryPath;
+    size_t us_MaxBytes;
+    bool b_Enabled;
+    
+protected:
+    
+};
+
+#endif /* PhraseStore_h */
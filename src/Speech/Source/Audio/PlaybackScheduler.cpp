@@ -0,0 +1,91 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+
+// External
+
+// Project
+#include "./PlaybackScheduler.h"
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+PlaybackScheduler::PlaybackScheduler(MRH_Uint32 u32_KHz, MRH_Uint32 u32_LeadMS) noexcept : u32_KHz(u32_KHz),
+                                                                                           u64_Lead((static_cast<MRH_Uint64>(u32_KHz) * u32_LeadMS) / 1000),
+                                                                                           u64_Sent(0),
+                                                                                           c_Start(std::chrono::steady_clock::now())
+{}
+
+PlaybackScheduler::~PlaybackScheduler() noexcept
+{}
+
+//*************************************************************************************
+// Reset
+//*************************************************************************************
+
+void PlaybackScheduler::Reset() noexcept
+{
+    u64_Sent = 0;
+    c_Start = std::chrono::steady_clock::now();
+}
+
+//*************************************************************************************
+// Add
+//*************************************************************************************
+
+void PlaybackScheduler::Add(size_t us_Samples) noexcept
+{
+    // @NOTE: The source stopped playing once all audio was played, 
+    //        new audio starts playback again
+    if (GetPlayed() >= u64_Sent)
+    {
+        Reset();
+    }
+    
+    u64_Sent += us_Samples;
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+size_t PlaybackScheduler::GetSendable() const noexcept
+{
+    MRH_Uint64 u64_Buffered = GetBuffered();
+    
+    if (u64_Buffered >= u64_Lead)
+    {
+        return 0;
+    }
+    
+    return static_cast<size_t>(u64_Lead - u64_Buffered);
+}
+
+size_t PlaybackScheduler::GetBuffered() const noexcept
+{
+    return static_cast<size_t>(u64_Sent - GetPlayed());
+}
+
+MRH_Uint64 PlaybackScheduler::GetPlayed() const noexcept
+{
+    MRH_Uint64 u64_ElapsedUS = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - c_Start).count();
+    MRH_Uint64 u64_Played = (u64_ElapsedUS * u32_KHz) / 1000000;
+    
+    return u64_Played < u64_Sent ? u64_Played : u64_Sent;
+}
@@ -0,0 +1,122 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef PlaybackScheduler_h
+#define PlaybackScheduler_h
+
+// C / C++
+#include <chrono>
+
+// External
+#include <MRH_Typedefs.h>
+
+// Project
+
+
+class PlaybackScheduler
+{
+public:
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     *
+     *  \param u32_KHz The playback KHz.
+     *  \param u32_LeadMS The audio in milliseconds sent ahead of playback.
+     */
+    
+    PlaybackScheduler(MRH_Uint32 u32_KHz, MRH_Uint32 u32_LeadMS) noexcept;
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~PlaybackScheduler() noexcept;
+    
+    //*************************************************************************************
+    // Reset
+    //*************************************************************************************
+    
+    /**
+     *  Reset the playback clock. All sent audio is considered played.
+     */
+    
+    void Reset() noexcept;
+    
+    //*************************************************************************************
+    // Add
+    //*************************************************************************************
+    
+    /**
+     *  Add sent audio. Playback restarts if all sent audio was played.
+     *
+     *  \param us_Samples The sent samples.
+     */
+    
+    void Add(size_t us_Samples) noexcept;
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the samples which can be sent without exceeding the lead.
+     *
+     *  \return The sendable sample count.
+     */
+    
+    size_t GetSendable() const noexcept;
+    
+    /**
+     *  Get the estimated samples sent but not yet played.
+     *
+     *  \return The buffered sample count.
+     */
+    
+    size_t GetBuffered() const noexcept;
+    
+private:
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the estimated samples played since playback started.
+     *
+     *  \return The played sample count.
+     */
+    
+    MRH_Uint64 GetPlayed() const noexcept;
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    MRH_Uint32 u32_KHz;
+    MRH_Uint64 u64_Lead;
+    
+    MRH_Uint64 u64_Sent; // Since playback start
+    std::chrono::steady_clock::time_point c_Start;
+    
+protected:
+    
+};
+
+#endif /* PlaybackScheduler_h */
@@ -0,0 +1,267 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+// C / C++
+#include <cmath>
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// External
+
+// Project
+#include "./Resampler.h"
+
+// Pre-defined
+#ifndef MRH_SPEECH_RESAMPLER_TAPS
+    #define MRH_SPEECH_RESAMPLER_TAPS 32 // Per phase, multiple of 8
+#endif
+#ifndef MRH_SPEECH_RESAMPLER_MAX_PHASES
+    #define MRH_SPEECH_RESAMPLER_MAX_PHASES 1024
+#endif
+#ifndef MRH_SPEECH_RESAMPLER_ROLLOFF
+    #define MRH_SPEECH_RESAMPLER_ROLLOFF 0.9
+#endif
+
+
+namespace
+{
+    //*************************************************************************************
+    // Dot Product
+    //*************************************************************************************
+    
+    float Dot(const float* p_A, const float* p_B, size_t us_Count) noexcept
+    {
+        size_t i = 0;
+        float f32_Sum;
+        
+#if defined(__AVX2__) && defined(__FMA__)
+        __m256 c_Sum = _mm256_setzero_ps();
+        
+        for (; (i + 8) <= us_Count; i += 8)
+        {
+            c_Sum = _mm256_fmadd_ps(_mm256_loadu_ps(p_A + i), _mm256_loadu_ps(p_B + i), c_Sum);
+        }
+        
+        __m128 c_Half = _mm_add_ps(_mm256_castps256_ps128(c_Sum), _mm256_extractf128_ps(c_Sum, 1));
+        c_Half = _mm_add_ps(c_Half, _mm_movehl_ps(c_Half, c_Half));
+        c_Half = _mm_add_ss(c_Half, _mm_shuffle_ps(c_Half, c_Half, 0x55));
+        
+        f32_Sum = _mm_cvtss_f32(c_Half);
+#elif defined(__ARM_NEON)
+        float32x4_t c_Sum = vdupq_n_f32(0.f);
+        
+        for (; (i + 4) <= us_Count; i += 4)
+        {
+            c_Sum = vmlaq_f32(c_Sum, vld1q_f32(p_A + i), vld1q_f32(p_B + i));
+        }
+        
+        float32x2_t c_Half = vadd_f32(vget_low_f32(c_Sum), vget_high_f32(c_Sum));
+        f32_Sum = vget_lane_f32(vpadd_f32(c_Half, c_Half), 0);
+#else
+        f32_Sum = 0.f;
+#endif
+        
+        // Remaining elements
+        for (; i < us_Count; ++i)
+        {
+            f32_Sum += p_A[i] * p_B[i];
+        }
+        
+        return f32_Sum;
+    }
+    
+    //*************************************************************************************
+    // Convert
+    //*************************************************************************************
+    
+    MRH_Sint16 ToSample(float f32_Value) noexcept
+    {
+        if (f32_Value >= 32767.f)
+        {
+            return 32767;
+        }
+        else if (f32_Value <= -32768.f)
+        {
+            return -32768;
+        }
+        
+        return static_cast<MRH_Sint16>(std::lrint(f32_Value));
+    }
+    
+    size_t GetDivisor(size_t us_A, size_t us_B) noexcept
+    {
+        while (us_B != 0)
+        {
+            size_t us_Rest = us_A % us_B;
+            us_A = us_B;
+            us_B = us_Rest;
+        }
+        
+        return us_A;
+    }
+}
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+Resampler::Resampler(MRH_Uint32 u32_InputKHz, MRH_Uint32 u32_OutputKHz) : u32_InputKHz(u32_InputKHz),
+                                                                           u32_OutputKHz(u32_OutputKHz),
+                                                                           us_Taps(MRH_SPEECH_RESAMPLER_TAPS),
+                                                                           us_Next(0),
+                                                                           us_Phase(0)
+{
+    if (u32_InputKHz == 0 || u32_OutputKHz == 0)
+    {
+        throw Exception("Invalid resampler KHz!");
+    }
+    
+    size_t us_Divisor = GetDivisor(u32_InputKHz, u32_OutputKHz);
+    
+    us_Up = u32_OutputKHz / us_Divisor;
+    us_Down = u32_InputKHz / us_Divisor;
+    
+    // @NOTE: Each output needs a full window of input
+    if (us_Up > MRH_SPEECH_RESAMPLER_MAX_PHASES || (us_Down / us_Up) >= us_Taps)
+    {
+        throw Exception("Unsupported resampler ratio " + std::to_string(u32_InputKHz) + 
+                        " to " + std::to_string(u32_OutputKHz) + "!");
+    }
+    
+    /**
+     *  Filter
+     */
+    
+    // Windowed sinc low pass at the upsampled rate, cutoff below the 
+    // lower nyquist frequency
+    size_t us_Length = us_Up * us_Taps;
+    double f64_Cutoff = (MRH_SPEECH_RESAMPLER_ROLLOFF * 0.5) / static_cast<double>(us_Up > us_Down ? us_Up : us_Down);
+    double f64_Center = (us_Length - 1) / 2.0;
+    double f64_Pi = std::acos(-1.0);
+    
+    try
+    {
+        v_Coefficient.resize(us_Length);
+    }
+    catch (std::exception& e)
+    {
+        throw Exception("Failed to allocate resampler filter: " + std::string(e.what()));
+    }
+    
+    for (size_t i = 0; i < us_Length; ++i)
+    {
+        double f64_X = i - f64_Center;
+        double f64_Sinc = (f64_X == 0.0) ? 2.0 * f64_Cutoff : std::sin(2.0 * f64_Pi * f64_Cutoff * f64_X) / (f64_Pi * f64_X);
+        double f64_Window = 0.42 - 0.5 * std::cos((2.0 * f64_Pi * i) / (us_Length - 1)) + 0.08 * std::cos((4.0 * f64_Pi * i) / (us_Length - 1)); // Blackman
+        
+        // Phase p, tap k stored at [p][Taps - 1 - k]
+        size_t us_Phase = i % us_Up;
+        size_t us_Tap = i / us_Up;
+        
+        v_Coefficient[(us_Phase * us_Taps) + (us_Taps - 1 - us_Tap)] = static_cast<float>(f64_Sinc * f64_Window * us_Up);
+    }
+    
+    Reset();
+}
+
+Resampler::~Resampler() noexcept
+{}
+
+//*************************************************************************************
+// Reset
+//*************************************************************************************
+
+void Resampler::Reset() noexcept
+{
+    // Start with a silent window
+    v_Input.assign(us_Taps - 1, 0.f);
+    
+    us_Next = us_Taps - 1;
+    us_Phase = 0;
+}
+
+//*************************************************************************************
+// Process
+//*************************************************************************************
+
+void Resampler::Process(const MRH_Sint16* p_Buffer, size_t us_Elements, std::vector<MRH_Sint16>& v_Output)
+{
+    v_Output.clear();
+    
+    try
+    {
+        size_t us_Kept = v_Input.size();
+        
+        v_Input.resize(us_Kept + us_Elements);
+        v_Output.reserve(((v_Input.size() - us_Next) * us_Up) / us_Down + 1);
+        
+        for (size_t i = 0; i < us_Elements; ++i)
+        {
+            v_Input[us_Kept + i] = p_Buffer[i];
+        }
+    }
+    catch (std::exception& e)
+    {
+        throw Exception("Failed to resample audio: " + std::string(e.what()));
+    }
+    
+    // Produce all outputs with a full input window
+    const float* p_Input = v_Input.data();
+    const float* p_Coefficient = v_Coefficient.data();
+    
+    while (us_Next < v_Input.size())
+    {
+        v_Output.push_back(ToSample(Dot(p_Coefficient + (us_Phase * us_Taps),
+                                        p_Input + (us_Next + 1 - us_Taps),
+                                        us_Taps)));
+        
+        us_Phase += us_Down;
+        us_Next += us_Phase / us_Up;
+        us_Phase %= us_Up;
+    }
+    
+    // Keep the window for the next output
+    size_t us_Drop = us_Next + 1 - us_Taps;
+    
+    v_Input.erase(v_Input.begin(), v_Input.begin() + us_Drop);
+    us_Next -= us_Drop;
+}
+
+void Resampler::Flush(std::vector<MRH_Sint16>& v_Output)
+{
+    // Push the filter delay out with silence
+    std::vector<MRH_Sint16> v_Silence(us_Taps / 2, 0);
+    
+    Process(v_Silence.data(), v_Silence.size(), v_Output);
+    Reset();
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+MRH_Uint32 Resampler::GetInputKHz() const noexcept
+{
+    return u32_InputKHz;
+}
+
+MRH_Uint32 Resampler::GetOutputKHz() const noexcept
+{
+    return u32_OutputKHz;
+}
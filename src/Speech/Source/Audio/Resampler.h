@@ -0,0 +1,131 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#ifndef Resampler_h
+#define Resampler_h
+
+// C / C++
+#include <vector>
+
+// External
+#include <MRH_Typedefs.h>
+
+// Project
+#include "../../../Exception.h"
+
+
+class Resampler
+{
+public:
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     *
+     *  \param u32_InputKHz The KHz of the audio to resample.
+     *  \param u32_OutputKHz The KHz of the resampled audio.
+     */
+    
+    Resampler(MRH_Uint32 u32_InputKHz, MRH_Uint32 u32_OutputKHz);
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~Resampler() noexcept;
+    
+    //*************************************************************************************
+    // Reset
+    //*************************************************************************************
+    
+    /**
+     *  Reset the resampler, discarding kept audio.
+     */
+    
+    void Reset() noexcept;
+    
+    //*************************************************************************************
+    // Process
+    //*************************************************************************************
+    
+    /**
+     *  Resample audio. Audio is processed continously, the end of the given 
+     *  audio is kept for the next call.
+     *
+     *  \param p_Buffer The audio buffer.
+     *  \param us_Elements The elements in the audio buffer.
+     *  \param v_Output The resampled audio. The vector is replaced.
+     */
+    
+    void Process(const MRH_Sint16* p_Buffer, size_t us_Elements, std::vector<MRH_Sint16>& v_Output);
+    
+    /**
+     *  Resample the kept audio and reset the resampler.
+     *
+     *  \param v_Output The resampled audio. The vector is replaced.
+     */
+    
+    void Flush(std::vector<MRH_Sint16>& v_Output);
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the KHz of the audio to resample.
+     *
+     *  \return The input KHz.
+     */
+    
+    MRH_Uint32 GetInputKHz() const noexcept;
+    
+    /**
+     *  Get the KHz of the resampled audio.
+     *
+     *  \return The output KHz.
+     */
+    
+    MRH_Uint32 GetOutputKHz() const noexcept;
+    
+private:
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    MRH_Uint32 u32_InputKHz;
+    MRH_Uint32 u32_OutputKHz;
+    
+    // Rational factor, output = input * Up / Down
+    size_t us_Up;
+    size_t us_Down;
+    
+    // @NOTE: Filter coefficients are stored per phase in reverse order, 
+    //        each phase is a dot product with the newest input
+    std::vector<float> v_Coefficient;
+    size_t us_Taps;
+    
+    std::vector<float> v_Input;
+    size_t us_Next;
+    size_t us_Phase;
+    
+protected:
+    
+};
+
+#endif /* Resampler_h */
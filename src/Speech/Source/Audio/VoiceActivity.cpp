@@ -0,0 +1,255 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+// C / C++
+#include <cstring>
+#include <cstdlib>
+
+// External
+
+// Project
+#include "./VoiceActivity.h"
+
+// Pre-defined
+#ifndef MRH_SPEECH_VAD_FRAME_MS
+    #define MRH_SPEECH_VAD_FRAME_MS 10
+#endif
+#ifndef MRH_SPEECH_VAD_ZERO_CROSSING_MAX
+    #define MRH_SPEECH_VAD_ZERO_CROSSING_MAX 0.35f // Share of sign changes per frame
+#endif
+#ifndef MRH_SPEECH_VAD_NOISE_FACTOR
+    #define MRH_SPEECH_VAD_NOISE_FACTOR 3.f
+#endif
+#ifndef MRH_SPEECH_VAD_NOISE_ADAPTION
+    #define MRH_SPEECH_VAD_NOISE_ADAPTION 0.05f
+#endif
+
+
+namespace
+{
+    size_t GetFrameSize(MRH_Uint32 u32_KHz)
+    {
+        size_t us_FrameSize = (static_cast<size_t>(u32_KHz) * MRH_SPEECH_VAD_FRAME_MS) / 1000;
+        
+        if (us_FrameSize < 2)
+        {
+            throw Exception("Invalid voice activity frame size!");
+        }
+        
+        return us_FrameSize;
+    }
+    
+    MRH_Uint32 GetFrameCount(MRH_Uint32 u32_MS) noexcept
+    {
+        MRH_Uint32 u32_Frames = u32_MS / MRH_SPEECH_VAD_FRAME_MS;
+        return u32_Frames > 0 ? u32_Frames : 1;
+    }
+}
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+VoiceActivity::VoiceActivity(MRH_Uint32 u32_KHz, MRH_Uint32 u32_Threshold, MRH_Uint32 u32_OnsetMS, MRH_Uint32 u32_HangoverMS, MRH_Uint32 u32_PreRollMS) : us_FrameFill(0),
+                                                                                                                                                            c_History(GetFrameSize(u32_KHz) * (GetFrameCount(u32_OnsetMS) + (u32_PreRollMS / MRH_SPEECH_VAD_FRAME_MS))),
+                                                                                                                                                            u32_OnsetFrames(GetFrameCount(u32_OnsetMS)),
+                                                                                                                                                            u32_PreRollFrames(u32_PreRollMS / MRH_SPEECH_VAD_FRAME_MS),
+                                                                                                                                                            u32_SpeechFrames(0),
+                                                                                                                                                            u32_HangoverFrames(GetFrameCount(u32_HangoverMS)),
+                                                                                                                                                            u32_SilentFrames(0),
+                                                                                                                                                            f32_Threshold(static_cast<float>(u32_Threshold)),
+                                                                                                                                                            f32_NoiseFloor(0.f),
+                                                                                                                                                            b_Speech(false)
+{
+    try
+    {
+        v_Frame.resize(GetFrameSize(u32_KHz), 0);
+    }
+    catch (std::exception& e)
+    {
+        throw Exception("Failed to allocate voice activity frame: " + std::string(e.what()));
+    }
+}
+
+VoiceActivity::~VoiceActivity() noexcept
+{}
+
+//*************************************************************************************
+// Reset
+//*************************************************************************************
+
+void VoiceActivity::Reset() noexcept
+{
+    us_FrameFill = 0;
+    
+    c_History.Clear();
+    u32_SpeechFrames = 0;
+    u32_SilentFrames = 0;
+    
+    b_Speech = false;
+}
+
+//*************************************************************************************
+// Process
+//*************************************************************************************
+
+size_t VoiceActivity::Process(const MRH_Sint16* p_Buffer, size_t us_Elements, AudioBuffer& c_Utterance, bool& b_End)
+{
+    size_t us_FrameSize = v_Frame.size();
+    size_t us_Processed = 0;
+    size_t us_Copy;
+    
+    b_End = false;
+    
+    while (us_Processed < us_Elements)
+    {
+        // Fill the current frame, frames span multiple buffers
+        us_Copy = us_FrameSize - us_FrameFill;
+        
+        if (us_Copy > (us_Elements - us_Processed))
+        {
+            us_Copy = us_Elements - us_Processed;
+        }
+        
+        std::memcpy(&(v_Frame[us_FrameFill]), p_Buffer + us_Processed, us_Copy * sizeof(MRH_Sint16));
+        
+        us_FrameFill += us_Copy;
+        us_Processed += us_Copy;
+        
+        if (us_FrameFill < us_FrameSize)
+        {
+            break;
+        }
+        
+        us_FrameFill = 0;
+        
+        if (ProcessFrame(c_Utterance) == true)
+        {
+            b_End = true;
+            break;
+        }
+    }
+    
+    return us_Processed;
+}
+
+bool VoiceActivity::ProcessFrame(AudioBuffer& c_Utterance)
+{
+    bool b_Voiced = GetVoiced();
+    
+    // Wait for enough speech to start the utterance
+    if (b_Speech == false)
+    {
+        // @NOTE: All frames are kept, the onset and the audio before
+        //        it belong to the utterance
+        c_History.Write(v_Frame.data(), v_Frame.size());
+        
+        if (b_Voiced == false)
+        {
+            u32_SpeechFrames = 0;
+            return false;
+        }
+        else if ((++u32_SpeechFrames) < u32_OnsetFrames)
+        {
+            return false;
+        }
+        
+        c_History.Splice(c_Utterance, v_Frame.size() * (u32_SpeechFrames + u32_PreRollFrames));
+        c_History.Clear();
+        
+        b_Speech = true;
+        u32_SilentFrames = 0;
+        c_SpeechEnd = std::chrono::steady_clock::now();
+        
+        return false;
+    }
+    
+    // In speech, keep everything until the hangover passed
+    c_Utterance.AddAudio(v_Frame);
+    
+    if (b_Voiced == true)
+    {
+        u32_SilentFrames = 0;
+        c_SpeechEnd = std::chrono::steady_clock::now();
+        
+        return false;
+    }
+    else if ((++u32_SilentFrames) < u32_HangoverFrames)
+    {
+        return false;
+    }
+    
+    b_Speech = false;
+    u32_SpeechFrames = 0;
+    
+    return true;
+}
+
+bool VoiceActivity::GetVoiced() noexcept
+{
+    const MRH_Sint16* p_Sample = v_Frame.data();
+    size_t us_FrameSize = v_Frame.size();
+    
+    MRH_Uint64 u64_Amplitude = std::abs(static_cast<int>(p_Sample[0]));
+    MRH_Uint32 u32_Crossings = 0;
+    
+    for (size_t i = 1; i < us_FrameSize; ++i)
+    {
+        u64_Amplitude += std::abs(static_cast<int>(p_Sample[i]));
+        
+        if ((p_Sample[i - 1] < 0) != (p_Sample[i] < 0))
+        {
+            ++u32_Crossings;
+        }
+    }
+    
+    float f32_Energy = static_cast<float>(u64_Amplitude) / us_FrameSize;
+    float f32_ZeroCrossing = static_cast<float>(u32_Crossings) / (us_FrameSize - 1);
+    
+    // Threshold follows the background noise
+    float f32_Limit = f32_NoiseFloor * MRH_SPEECH_VAD_NOISE_FACTOR;
+    
+    if (f32_Limit < f32_Threshold)
+    {
+        f32_Limit = f32_Threshold;
+    }
+    
+    // @NOTE: Quiet frames with many zero crossings are noise, loud 
+    //        frames always count as speech
+    bool b_Voiced = f32_Energy >= f32_Limit && 
+                    (f32_ZeroCrossing <= MRH_SPEECH_VAD_ZERO_CROSSING_MAX || f32_Energy >= (f32_Limit * 2.f));
+    
+    if (b_Voiced == false)
+    {
+        f32_NoiseFloor += (f32_Energy - f32_NoiseFloor) * MRH_SPEECH_VAD_NOISE_ADAPTION;
+    }
+    
+    return b_Voiced;
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+bool VoiceActivity::GetSpeech() const noexcept
+{
+    return b_Speech;
+}
+
+std::chrono::steady_clock::time_point VoiceActivity::GetSpeechEnd() const noexcept
+{
+    return c_SpeechEnd;
+}
@@ -0,0 +1,157 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#ifndef VoiceActivity_h
+#define VoiceActivity_h
+
+// C / C++
+#include <vector>
+#include <chrono>
+
+// External
+#include <MRH_Typedefs.h>
+
+// Project
+#include "./AudioBuffer.h"
+#include "./AudioRing.h"
+
+
+class VoiceActivity
+{
+public:
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     *
+     *  \param u32_KHz The KHz of the processed audio.
+     *  \param u32_Threshold The minimum average amplitude of speech.
+     *  \param u32_OnsetMS The speech required in milliseconds before a utterance starts.
+     *  \param u32_HangoverMS The silence required in milliseconds before a utterance ends.
+     *  \param u32_PreRollMS The audio in milliseconds before the onset added to a utterance.
+     */
+    
+    VoiceActivity(MRH_Uint32 u32_KHz, MRH_Uint32 u32_Threshold, MRH_Uint32 u32_OnsetMS, MRH_Uint32 u32_HangoverMS, MRH_Uint32 u32_PreRollMS);
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~VoiceActivity() noexcept;
+    
+    //*************************************************************************************
+    // Reset
+    //*************************************************************************************
+    
+    /**
+     *  Reset the detection state and discard unprocessed audio.
+     */
+    
+    void Reset() noexcept;
+    
+    //*************************************************************************************
+    // Process
+    //*************************************************************************************
+    
+    /**
+     *  Process audio and add utterance audio to a buffer. Processing stops 
+     *  after the end of a utterance was detected.
+     *
+     *  \param p_Buffer The audio buffer.
+     *  \param us_Elements The elements in the audio buffer.
+     *  \param c_Utterance The buffer to add utterance audio to.
+     *  \param b_End If the end of a utterance was detected.
+     *
+     *  \return The amount of processed elements.
+     */
+    
+    size_t Process(const MRH_Sint16* p_Buffer, size_t us_Elements, AudioBuffer& c_Utterance, bool& b_End);
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get if a utterance is in progress.
+     *
+     *  \return true if in progress, false if not.
+     */
+    
+    bool GetSpeech() const noexcept;
+    
+    /**
+     *  Get the time the last speech frame was processed.
+     *
+     *  \return The last speech time point.
+     */
+    
+    std::chrono::steady_clock::time_point GetSpeechEnd() const noexcept;
+    
+private:
+    
+    //*************************************************************************************
+    // Process
+    //*************************************************************************************
+    
+    /**
+     *  Process the current frame.
+     *
+     *  \param c_Utterance The buffer to add utterance audio to.
+     *
+     *  \return true if the utterance ended, false if not.
+     */
+    
+    bool ProcessFrame(AudioBuffer& c_Utterance);
+    
+    /**
+     *  Check if the current frame contains speech.
+     *
+     *  \return true if speech, false if not.
+     */
+    
+    bool GetVoiced() noexcept;
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    // Frame
+    std::vector<MRH_Sint16> v_Frame;
+    size_t us_FrameFill;
+    
+    // Onset
+    AudioRing c_History;
+    MRH_Uint32 u32_OnsetFrames;
+    MRH_Uint32 u32_PreRollFrames;
+    MRH_Uint32 u32_SpeechFrames;
+    
+    // Hangover
+    MRH_Uint32 u32_HangoverFrames;
+    MRH_Uint32 u32_SilentFrames;
+    
+    // Detection
+    float f32_Threshold;
+    float f32_NoiseFloor;
+    bool b_Speech;
+    std::chrono::steady_clock::time_point c_SpeechEnd;
+    
+protected:
+    
+};
+
+#endif /* VoiceActivity_h */
@@ -0,0 +1,147 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+
+// External
+
+// Project
+#include "./Recognizer.h"
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+Recognizer::Recognizer(Configuration const& c_Configuration,
+#if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
+                       GoogleCloudAPI::Client& c_GoogleCloudAPI,
+#endif
+                       Signal& c_Signal) : RequestStage(c_Signal,
+                                                        c_Configuration.GetVoiceRecognizeRequests()),
+                                           c_Trim(c_Configuration.GetVoiceSilenceThreshold(),
+                                                  c_Configuration.GetVoiceSilencePaddingMS(),
+                                                  c_Configuration.GetVoiceSilenceMaxPauseMS()),
+                                           b_Trim(c_Configuration.GetVoiceSilenceTrim()),
+                                           c_Encoder(static_cast<AudioEncoder::Encoding>(c_Configuration.GetVoiceUploadEncoding()),
+                                                     c_Configuration.GetVoiceUploadBitrate()),
+#if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
+                                           c_GoogleCloudAPI(c_GoogleCloudAPI),
+                                           s_GoogleLangCode(c_Configuration.GetGoogleLanguageCode()),
+                                           u32_GoogleDeadlineMS(c_Configuration.GetGoogleRequestDeadlineMS()),
+#endif
+                                           e_APIProvider(static_cast<APIProvider>(c_Configuration.GetVoiceAPIProvider()))
+{}
+
+Recognizer::~Recognizer() noexcept
+{
+    // @NOTE: Active requests complete on this stage, stop before destruction
+    Stop();
+}
+
+//*************************************************************************************
+// Perform
+//*************************************************************************************
+
+void Recognizer::Perform(MRH_Uint64 u64_Sequence, AudioBuffer& c_Audio)
+{
+    // Only upload the spoken part of the audio
+    if (b_Trim == true)
+    {
+        AudioBuffer c_Trimmed(c_Audio.GetKHz(), AudioPool::CAPTURE);
+        c_Trim.Process(c_Audio, c_Trimmed);
+        
+        if (c_Trimmed.GetSampleCount() == 0)
+        {
+            Fail(u64_Sequence);
+            return;
+        }
+        
+        c_Audio = std::move(c_Trimmed);
+    }
+    
+    switch (e_APIProvider)
+    {
+#if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
+        case GOOGLE_CLOUD_API:
+        {
+            GoogleCloudAPI::TranscribeCallback f_Callback = [this, u64_Sequence](std::string* p_Transcript)
+            {
+                if (p_Transcript == NULL)
+                {
+                    Fail(u64_Sequence);
+                }
+                else
+                {
+                    Complete(u64_Sequence, std::move(*p_Transcript));
+                }
+            };
+            
+            if (c_Encoder.GetEncoding() == AudioEncoder::LINEAR16)
+            {
+                c_GoogleCloudAPI.Transcribe(c_Audio,
+                                            s_GoogleLangCode,
+                                            u32_GoogleDeadlineMS,
+                                            f_Callback);
+                break;
+            }
+            
+            // @NOTE: Compressed audio is encoded on the encoder thread, 
+            //        the upload starts once finished
+            c_Encoder.Encode(std::move(c_Audio), [this, u64_Sequence, f_Callback](AudioEncoder::Output* p_Audio)
+            {
+                if (p_Audio == NULL)
+                {
+                    Fail(u64_Sequence);
+                    return;
+                }
+                
+                try
+                {
+                    c_GoogleCloudAPI.Transcribe(*p_Audio,
+                                                s_GoogleLangCode,
+                                                u32_GoogleDeadlineMS,
+                                                f_Callback);
+                }
+                catch (std::exception& e)
+                {
+                    MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::ERROR, e.what(),
+                                                   "Recognizer.cpp", __LINE__);
+                    Fail(u64_Sequence);
+                }
+            });
+            break;
+        }
+#endif
+        default:
+            throw Exception("Unknown API provider!");
+    }
+}
+
+void Recognizer::Cancel() noexcept
+{
+    switch (e_APIProvider)
+    {
+#if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
+        case GOOGLE_CLOUD_API:
+            c_Encoder.Cancel();
+            c_GoogleCloudAPI.Cancel(GoogleCloudAPI::TRANSCRIBE);
+            break;
+#endif
+        default:
+            break;
+    }
+}
@@ -0,0 +1,92 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+
+// External
+
+// Project
+#include "./StreamRecognizer.h"
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+StreamRecognizer::StreamRecognizer(Configuration const& c_Configuration,
+#if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
+                                   GoogleCloudAPI::Client& c_GoogleCloudAPI,
+#endif
+                                   Signal& c_Signal) : RequestStage(c_Signal,
+                                                                    c_Configuration.GetVoiceRecognizeRequests()),
+#if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
+                                                       c_GoogleCloudAPI(c_GoogleCloudAPI),
+                                                       s_GoogleLangCode(c_Configuration.GetGoogleLanguageCode()),
+                                                       u32_GoogleDeadlineMS(c_Configuration.GetGoogleRequestDeadlineMS()),
+#endif
+                                                       e_APIProvider(static_cast<APIProvider>(c_Configuration.GetVoiceAPIProvider()))
+{}
+
+StreamRecognizer::~StreamRecognizer() noexcept
+{
+    // @NOTE: Active requests complete on this stage, stop before destruction
+    Stop();
+}
+
+//*************************************************************************************
+// Perform
+//*************************************************************************************
+
+void StreamRecognizer::Perform(MRH_Uint64 u64_Sequence, std::shared_ptr<AudioStream>& p_Stream)
+{
+    switch (e_APIProvider)
+    {
+#if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
+        case GOOGLE_CLOUD_API:
+            c_GoogleCloudAPI.StreamTranscribe(p_Stream,
+                                              s_GoogleLangCode,
+                                              u32_GoogleDeadlineMS,
+                                              [this, u64_Sequence](std::string* p_Transcript)
+                                              {
+                                                  if (p_Transcript == NULL)
+                                                  {
+                                                      Fail(u64_Sequence);
+                                                  }
+                                                  else
+                                                  {
+                                                      Complete(u64_Sequence, std::move(*p_Transcript));
+                                                  }
+                                              });
+            break;
+#endif
+        default:
+            throw Exception("Unknown API provider!");
+    }
+}
+
+void StreamRecognizer::Cancel() noexcept
+{
+    switch (e_APIProvider)
+    {
+#if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
+        case GOOGLE_CLOUD_API:
+            c_GoogleCloudAPI.Cancel(GoogleCloudAPI::TRANSCRIBE);
+            break;
+#endif
+        default:
+            break;
+    }
+}
@@ -0,0 +1,100 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef StreamRecognizer_h
+#define StreamRecognizer_h
+
+// C / C++
+#include <string>
+#include <memory>
+
+// External
+
+// Project
+#include "./APIProvider/APIProvider.h"
+#if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
+#include "./APIProvider/GoogleCloudAPI.h"
+#endif
+#include "./Audio/AudioStream.h"
+#include "../RequestStage.h"
+#include "../../Configuration.h"
+
+
+class StreamRecognizer : public RequestStage<std::shared_ptr<AudioStream>, std::string>
+{
+public:
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     *
+     *  \param c_Configuration The configuration to construct with.
+     *  \param c_GoogleCloudAPI The google cloud api client to transcribe with.
+     *  \param c_Signal The signal notified when audio was transcribed.
+     */
+    
+    StreamRecognizer(Configuration const& c_Configuration,
+#if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
+                     GoogleCloudAPI::Client& c_GoogleCloudAPI,
+#endif
+                     Signal& c_Signal);
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~StreamRecognizer() noexcept;
+    
+private:
+    
+    //*************************************************************************************
+    // Perform
+    //*************************************************************************************
+    
+    /**
+     *  Start transcribing streamed audio while it is recorded.
+     *
+     *  \param u64_Sequence The sequence of the audio stream.
+     *  \param p_Stream The audio stream to transcribe.
+     */
+    
+    void Perform(MRH_Uint64 u64_Sequence, std::shared_ptr<AudioStream>& p_Stream) override;
+    
+    /**
+     *  Cancel all active transcriptions.
+     */
+    
+    void Cancel() noexcept override;
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+#if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
+    GoogleCloudAPI::Client& c_GoogleCloudAPI;
+    std::string s_GoogleLangCode;
+    MRH_Uint32 u32_GoogleDeadlineMS;
+#endif
+    APIProvider e_APIProvider;
+    
+protected:
+    
+};
+
+#endif /* StreamRecognizer_h */
@@ -0,0 +1,381 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <chrono>
+
+// External
+
+// Project
+#include "./Synthesizer.h"
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+Synthesizer::Synthesizer(Configuration const& c_Configuration,
+#if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
+                         GoogleCloudAPI::Client& c_GoogleCloudAPI,
+#endif
+                         Signal& c_Signal) : RequestStage(c_Signal,
+                                                          c_Configuration.GetVoiceSynthesizeRequests()),
+                                             u32_KHz(c_Configuration.GetVoiceSynthesisKHz()),
+                                             c_Segmenter(c_Configuration.GetVoiceSegmentSynthesis(),
+                                                         c_Configuration.GetVoiceSegmentMinLength(),
+                                                         c_Configuration.GetVoiceSegmentMaxLength()),
+                                             c_Trim(c_Configuration.GetVoiceSilenceThreshold(),
+                                                    c_Configuration.GetVoiceSilencePaddingMS(),
+                                                    c_Configuration.GetVoiceSilenceMaxPauseMS()),
+                                             b_Trim(c_Configuration.GetVoiceSilenceTrim()),
+                                             c_Cache(static_cast<size_t>(c_Configuration.GetVoiceSynthesisCacheKB()) * 1024),
+                                             c_Store(c_Configuration.GetVoicePhraseStorePath(),
+                                                     static_cast<size_t>(c_Configuration.GetVoicePhraseStoreMB()) * 1024 * 1024),
+#if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
+                                             c_GoogleCloudAPI(c_GoogleCloudAPI),
+                                             s_GoogleLangCode(c_Configuration.GetGoogleLanguageCode()),
+                                             u8_GoogleVoiceGender(c_Configuration.GetGoogleVoiceGender()),
+                                             u32_GoogleDeadlineMS(c_Configuration.GetGoogleRequestDeadlineMS()),
+#endif
+                                             e_APIProvider(static_cast<APIProvider>(c_Configuration.GetVoiceAPIProvider())),
+                                             u32_PresynthesisActive(0),
+                                             u32_PresynthesisMax(c_Configuration.GetVoicePresynthesisRequests() > 0 ? c_Configuration.GetVoicePresynthesisRequests() : 1),
+                                             b_Presynthesis(true)
+{
+    // Synthesise common phrases in the background
+    // @NOTE: Only useful if synthesised audio is kept
+    if (c_Cache.GetEnabled() == false && c_Store.GetEnabled() == false)
+    {
+        return;
+    }
+    
+    try
+    {
+        std::vector<std::string> v_Segment;
+        
+        // @NOTE: Phrases are split like output, the segments are kept
+        for (auto& Phrase : c_Configuration.GetVoicePresynthesis())
+        {
+            c_Segmenter.Split(Phrase, v_Segment);
+            dq_Presynthesis.insert(dq_Presynthesis.end(), v_Segment.begin(), v_Segment.end());
+        }
+    }
+    catch (std::exception& e)
+    {
+        throw Exception("Failed to add pre-synthesis phrases: " + std::string(e.what()));
+    }
+    
+    Presynthesise(false);
+}
+
+Synthesizer::~Synthesizer() noexcept
+{
+    // No new pre-synthesis
+    {
+        std::lock_guard<std::mutex> c_Guard(c_PresynthesisMutex);
+        
+        dq_Presynthesis.clear();
+        b_Presynthesis = false;
+    }
+    
+    // @NOTE: Active requests complete on this stage, stop before destruction
+    Stop();
+    
+    // Pre-synthesis is not cancelled by stopping
+    switch (e_APIProvider)
+    {
+#if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
+        case GOOGLE_CLOUD_API:
+            c_GoogleCloudAPI.Cancel(GoogleCloudAPI::PRESYNTHESISE);
+            break;
+#endif
+        default:
+            break;
+    }
+    
+    std::unique_lock<std::mutex> c_Lock(c_PresynthesisMutex);
+    c_PresynthesisCondition.wait(c_Lock, [this]()
+    {
+        return u32_PresynthesisActive == 0;
+    });
+}
+
+SynthesizerInput::SynthesizerInput(std::string const& s_String,
+                                   MRH_Uint32 u32_StringID,
+                                   MRH_Uint32 u32_GroupID,
+                                   bool b_LastSegment) noexcept : s_String(s_String),
+                                                                  u32_StringID(u32_StringID),
+                                                                  u32_GroupID(u32_GroupID),
+                                                                  b_LastSegment(b_LastSegment)
+{}
+
+SynthesizerOutput::SynthesizerOutput(MRH_Uint32 u32_KHz,
+                                     MRH_Uint32 u32_StringID,
+                                     MRH_Uint32 u32_GroupID,
+                                     bool b_LastSegment) noexcept : c_Audio(u32_KHz, AudioPool::PLAYBACK),
+                                                                    u32_StringID(u32_StringID),
+                                                                    u32_GroupID(u32_GroupID),
+                                                                    b_LastSegment(b_LastSegment)
+{}
+
+//*************************************************************************************
+// Add
+//*************************************************************************************
+
+void Synthesizer::AddString(OutputStorage::String const& c_String)
+{
+    std::vector<std::string> v_Segment;
+    
+    try
+    {
+        c_Segmenter.Split(c_String.s_String, v_Segment);
+    }
+    catch (std::exception& e)
+    {
+        throw Exception("Failed to split output string: " + std::string(e.what()));
+    }
+    
+    // Nothing to split, synthesize as given
+    if (v_Segment.size() == 0)
+    {
+        Add(SynthesizerInput(c_String.s_String, c_String.u32_StringID, c_String.u32_GroupID, true));
+        return;
+    }
+    
+    for (size_t i = 0; i < v_Segment.size(); ++i)
+    {
+        Add(SynthesizerInput(v_Segment[i], c_String.u32_StringID, c_String.u32_GroupID, (i + 1) == v_Segment.size()));
+    }
+}
+
+//*************************************************************************************
+// Perform
+//*************************************************************************************
+
+void Synthesizer::Perform(MRH_Uint64 u64_Sequence, SynthesizerInput& c_Input)
+{
+    switch (e_APIProvider)
+    {
+#if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
+        case GOOGLE_CLOUD_API:
+        {
+            MRH_Uint32 u32_StringID = c_Input.u32_StringID;
+            MRH_Uint32 u32_GroupID = c_Input.u32_GroupID;
+            bool b_LastSegment = c_Input.b_LastSegment;
+            std::string s_Key;
+            
+            if (c_Cache.GetEnabled() == true || c_Store.GetEnabled() == true)
+            {
+                s_Key = GetKey(c_Input.s_String, s_GoogleLangCode, u8_GoogleVoiceGender);
+                
+                SynthesizerOutput c_Output(u32_KHz,
+                                           u32_StringID,
+                                           u32_GroupID,
+                                           b_LastSegment);
+                
+                // @NOTE: Stored phrases are played from the store file without copying
+                if ((c_Cache.GetEnabled() == true && c_Cache.GetAudio(s_Key, c_Output.c_Audio) == true) || 
+                    c_Store.GetPhrase(s_Key, c_Output.c_Phrase) == true)
+                {
+                    Complete(u64_Sequence, std::move(c_Output));
+                    return;
+                }
+            }
+            
+            std::chrono::steady_clock::time_point c_Start = std::chrono::steady_clock::now();
+            
+            c_GoogleCloudAPI.Synthesise(c_Input.s_String,
+                                        u32_KHz,
+                                        s_GoogleLangCode,
+                                        u8_GoogleVoiceGender,
+                                        u32_GoogleDeadlineMS,
+                                        GoogleCloudAPI::SYNTHESISE,
+                                        [this, u64_Sequence, u32_StringID, u32_GroupID, b_LastSegment, s_Key, c_Start](AudioBuffer* p_Audio)
+                                        {
+                                            // @NOTE: Failed segments complete without audio, the 
+                                            //        string still ends with its last segment
+                                            SynthesizerOutput c_Output(p_Audio != NULL ? p_Audio->GetKHz() : u32_KHz,
+                                                                       u32_StringID,
+                                                                       u32_GroupID,
+                                                                       b_LastSegment);
+                                            
+                                            if (p_Audio != NULL)
+                                            {
+                                                try
+                                                {
+                                                    AddAudio(s_Key, *p_Audio, c_Output.c_Audio, c_Start);
+                                                }
+                                                catch (...)
+                                                {
+                                                    c_Output.c_Audio.Clear(u32_KHz);
+                                                }
+                                            }
+                                            
+                                            Complete(u64_Sequence, std::move(c_Output));
+                                        });
+            break;
+        }
+#endif
+        default:
+            throw Exception("Unknown API provider!");
+    }
+}
+
+void Synthesizer::Cancel() noexcept
+{
+    switch (e_APIProvider)
+    {
+#if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
+        case GOOGLE_CLOUD_API:
+            c_GoogleCloudAPI.Cancel(GoogleCloudAPI::SYNTHESISE);
+            break;
+#endif
+        default:
+            break;
+    }
+}
+
+//*************************************************************************************
+// Presynthesise
+//*************************************************************************************
+
+void Synthesizer::Presynthesise(bool b_Completed) noexcept
+{
+    std::unique_lock<std::mutex> c_Lock(c_PresynthesisMutex);
+    
+    if (b_Completed == true)
+    {
+        --u32_PresynthesisActive;
+    }
+    
+    while (b_Presynthesis == true && 
+           u32_PresynthesisActive < u32_PresynthesisMax && 
+           dq_Presynthesis.size() > 0)
+    {
+        std::string s_String(std::move(dq_Presynthesis.front()));
+        dq_Presynthesis.pop_front();
+        
+        ++u32_PresynthesisActive;
+        
+        // @NOTE: Requests might complete while starting, never hold 
+        //        the lock when synthesising
+        c_Lock.unlock();
+        
+        bool b_Started = false;
+        
+        try
+        {
+            switch (e_APIProvider)
+            {
+#if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
+                case GOOGLE_CLOUD_API:
+                {
+                    // @NOTE: Keyed like output, which always uses the provider voice
+                    std::string s_Key = GetKey(s_String, s_GoogleLangCode, u8_GoogleVoiceGender);
+                    
+                    // Kept from the last run?
+                    // @NOTE: Clearing output keeps pre-synthesis requests
+                    if (c_Cache.GetCached(s_Key) == true || c_Store.GetStored(s_Key) == true)
+                    {
+                        break;
+                    }
+                    
+                    std::chrono::steady_clock::time_point c_Start = std::chrono::steady_clock::now();
+                    
+                    c_GoogleCloudAPI.Synthesise(s_String,
+                                                u32_KHz,
+                                                s_GoogleLangCode,
+                                                u8_GoogleVoiceGender,
+                                                u32_GoogleDeadlineMS,
+                                                GoogleCloudAPI::PRESYNTHESISE,
+                                                [this, s_Key, c_Start](AudioBuffer* p_Audio)
+                                                {
+                                                    if (p_Audio != NULL)
+                                                    {
+                                                        try
+                                                        {
+                                                            AudioBuffer c_Output(p_Audio->GetKHz(), AudioPool::PLAYBACK);
+                                                            AddAudio(s_Key, *p_Audio, c_Output, c_Start);
+                                                        }
+                                                        catch (...)
+                                                        {}
+                                                    }
+                                                    
+                                                    // @NOTE: Nothing is used after completing, the 
+                                                    //        synthesizer might be destroyed
+                                                    Presynthesise(true);
+                                                });
+                    b_Started = true;
+                    break;
+                }
+#endif
+                default:
+                    break;
+            }
+        }
+        catch (std::exception& e)
+        {
+            MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::WARNING, "Failed to pre-synthesise phrase: " + std::string(e.what()),
+                                           "Synthesizer.cpp", __LINE__);
+        }
+        
+        c_Lock.lock();
+        
+        if (b_Started == false)
+        {
+            --u32_PresynthesisActive;
+        }
+    }
+    
+    c_PresynthesisCondition.notify_all();
+}
+
+//*************************************************************************************
+// Audio
+//*************************************************************************************
+
+void Synthesizer::AddAudio(std::string const& s_Key, AudioBuffer& c_Audio, AudioBuffer& c_Output, std::chrono::steady_clock::time_point c_Start)
+{
+    if (b_Trim == true)
+    {
+        c_Trim.Process(c_Audio, c_Output);
+    }
+    
+    // @NOTE: Keep audio which was only silence, the string has to be played
+    if (c_Output.GetSampleCount() == 0)
+    {
+        c_Output = std::move(c_Audio);
+    }
+    
+    if (s_Key.size() > 0)
+    {
+        c_Cache.Add(s_Key, c_Output, std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - c_Start).count());
+        c_Store.Add(s_Key, c_Output);
+    }
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+std::string Synthesizer::GetKey(std::string const& s_String, std::string const& s_LangCode, MRH_Uint8 u8_VoiceGender) const
+{
+    // Same string, voice and audio format give the same audio
+    return s_LangCode + '\n' + 
+           std::to_string(u8_VoiceGender) + '\n' + 
+           std::to_string(u32_KHz) + '\n' + 
+           s_String;
+}
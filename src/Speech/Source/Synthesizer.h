@@ -0,0 +1,245 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef Synthesizer_h
+#define Synthesizer_h
+
+// C / C++
+#include <string>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+// External
+
+// Project
+#include "./APIProvider/APIProvider.h"
+#if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
+#include "./APIProvider/GoogleCloudAPI.h"
+#endif
+#include "./Audio/AudioBuffer.h"
+#include "./Audio/AudioTrim.h"
+#include "./Audio/AudioCache.h"
+#include "./Audio/PhraseStore.h"
+#include "./TextSegmenter.h"
+#include "../RequestStage.h"
+#include "../OutputStorage.h"
+#include "../../Configuration.h"
+
+
+class SynthesizerInput
+{
+public:
+    
+    //*************************************************************************************
+    // Constructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     *
+     *  \param s_String The string segment to synthesize.
+     *  \param u32_StringID The id of the output string.
+     *  \param u32_GroupID The id of the output string event group.
+     *  \param b_LastSegment If this is the last segment of the output string.
+     */
+    
+    SynthesizerInput(std::string const& s_String,
+                     MRH_Uint32 u32_StringID,
+                     MRH_Uint32 u32_GroupID,
+                     bool b_LastSegment) noexcept;
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    std::string s_String;
+    MRH_Uint32 u32_StringID;
+    MRH_Uint32 u32_GroupID;
+    bool b_LastSegment;
+};
+
+class SynthesizerOutput
+{
+public:
+    
+    //*************************************************************************************
+    // Constructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     *
+     *  \param u32_KHz The synthesized audio KHz.
+     *  \param u32_StringID The id of the synthesized string.
+     *  \param u32_GroupID The id of the synthesized string event group.
+     *  \param b_LastSegment If this is the last segment of the synthesized string.
+     */
+    
+    SynthesizerOutput(MRH_Uint32 u32_KHz,
+                      MRH_Uint32 u32_StringID,
+                      MRH_Uint32 u32_GroupID,
+                      bool b_LastSegment) noexcept;
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    AudioBuffer c_Audio;
+    PhraseStore::Phrase c_Phrase; // Used instead of the audio buffer if set
+    MRH_Uint32 u32_StringID;
+    MRH_Uint32 u32_GroupID;
+    bool b_LastSegment;
+};
+
+class Synthesizer : public RequestStage<SynthesizerInput, SynthesizerOutput>
+{
+public:
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     *
+     *  \param c_Configuration The configuration to construct with.
+     *  \param c_GoogleCloudAPI The google cloud api client to synthesize with.
+     *  \param c_Signal The signal notified when a string was synthesized.
+     */
+    
+    Synthesizer(Configuration const& c_Configuration,
+#if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
+                GoogleCloudAPI::Client& c_GoogleCloudAPI,
+#endif
+                Signal& c_Signal);
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~Synthesizer() noexcept;
+    
+    //*************************************************************************************
+    // Add
+    //*************************************************************************************
+    
+    /**
+     *  Split a output string into segments and add them for synthesis. Segments 
+     *  are synthesized in parallel and returned in order. This function is 
+     *  thread safe.
+     *
+     *  \param c_String The string to add.
+     */
+    
+    void AddString(OutputStorage::String const& c_String);
+    
+private:
+    
+    //*************************************************************************************
+    // Perform
+    //*************************************************************************************
+    
+    /**
+     *  Start synthesizing a output string segment.
+     *
+     *  \param u64_Sequence The sequence of the string segment.
+     *  \param c_Input The string segment to synthesize.
+     */
+    
+    void Perform(MRH_Uint64 u64_Sequence, SynthesizerInput& c_Input) override;
+    
+    /**
+     *  Cancel all active syntheses.
+     */
+    
+    void Cancel() noexcept override;
+    
+    //*************************************************************************************
+    // Presynthesise
+    //*************************************************************************************
+    
+    /**
+     *  Start synthesising queued pre-synthesis phrases up to the request limit.
+     *
+     *  \param b_Completed If a pre-synthesis request completed.
+     */
+    
+    void Presynthesise(bool b_Completed) noexcept;
+    
+    //*************************************************************************************
+    // Audio
+    //*************************************************************************************
+    
+    /**
+     *  Trim synthesised audio and keep it for repeated strings.
+     *
+     *  \param s_Key The key of the synthesised string, empty if not kept.
+     *  \param c_Audio The synthesised audio. The audio might be moved.
+     *  \param c_Output The audio to play.
+     *  \param c_Start The time point the synthesis started.
+     */
+    
+    void AddAudio(std::string const& s_Key, AudioBuffer& c_Audio, AudioBuffer& c_Output, std::chrono::steady_clock::time_point c_Start);
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the key identifying synthesised audio.
+     *
+     *  \param s_String The synthesised string.
+     *  \param s_LangCode The language code of the voice.
+     *  \param u8_VoiceGender The gender of the voice.
+     *
+     *  \return The audio key.
+     */
+    
+    std::string GetKey(std::string const& s_String, std::string const& s_LangCode, MRH_Uint8 u8_VoiceGender) const;
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    MRH_Uint32 u32_KHz;
+    TextSegmenter c_Segmenter;
+    AudioTrim c_Trim;
+    bool b_Trim;
+    AudioCache c_Cache;
+    PhraseStore c_Store;
+    
+#if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
+    GoogleCloudAPI::Client& c_GoogleCloudAPI;
+    std::string s_GoogleLangCode;
+    MRH_Uint8 u8_GoogleVoiceGender;
+    MRH_Uint32 u32_GoogleDeadlineMS;
+#endif
+    APIProvider e_APIProvider;
+    
+    std::mutex c_PresynthesisMutex;
+    std::condition_variable c_PresynthesisCondition;
+    std::deque<std::string> dq_Presynthesis;
+    MRH_Uint32 u32_PresynthesisActive;
+    MRH_Uint32 u32_PresynthesisMax;
+    bool b_Presynthesis;
+    
+protected:
+    
+};
+
+#endif /* Synthesizer_h */
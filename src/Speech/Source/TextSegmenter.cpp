@@ -0,0 +1,232 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <cstring>
+
+// External
+
+// Project
+#include "./TextSegmenter.h"
+
+// Pre-defined
+namespace
+{
+    struct Punctuation
+    {
+        const char* p_CodePoint;
+        bool b_Sentence;
+        bool b_Spaced;
+    };
+    
+    // @NOTE: Full width punctuation is used without following whitespace
+    constexpr Punctuation p_Punctuation[] =
+    {
+        { ".", true, true },
+        { "!", true, true },
+        { "?", true, true },
+        { "\xE2\x80\xA6", true, true }, // Ellipsis
+        { "\xE3\x80\x82", true, false }, // Ideographic full stop
+        { "\xEF\xBC\x81", true, false }, // Full width exclamation mark
+        { "\xEF\xBC\x9F", true, false }, // Full width question mark
+        { ",", false, true },
+        { ";", false, true },
+        { ":", false, true },
+        { "\xE3\x80\x81", false, false }, // Ideographic comma
+        { "\xEF\xBC\x8C", false, false }, // Full width comma
+        { "\xEF\xBC\x9B", false, false }, // Full width semicolon
+        { "\xEF\xBC\x9A", false, false } // Full width colon
+    };
+    
+    inline size_t GetCodePointLength(unsigned char c_Lead) noexcept
+    {
+        if (c_Lead < 0x80)
+        {
+            return 1;
+        }
+        else if ((c_Lead & 0xE0) == 0xC0)
+        {
+            return 2;
+        }
+        else if ((c_Lead & 0xF0) == 0xE0)
+        {
+            return 3;
+        }
+        else if ((c_Lead & 0xF8) == 0xF0)
+        {
+            return 4;
+        }
+        
+        // @NOTE: Invalid lead byte, step over it alone
+        return 1;
+    }
+    
+    inline bool GetSpace(char c_Char) noexcept
+    {
+        return c_Char == ' ' || c_Char == '\t' || c_Char == '\n' || c_Char == '\r';
+    }
+    
+    inline bool GetClosing(char c_Char) noexcept
+    {
+        return c_Char == '"' || c_Char == '\'' || c_Char == ')' || c_Char == ']';
+    }
+}
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+TextSegmenter::TextSegmenter(bool b_Enabled, MRH_Uint32 u32_MinLength, MRH_Uint32 u32_MaxLength) noexcept : b_Enabled(b_Enabled),
+                                                                                                            us_MinLength(u32_MinLength),
+                                                                                                            us_MaxLength(u32_MaxLength)
+{}
+
+TextSegmenter::~TextSegmenter() noexcept
+{}
+
+//*************************************************************************************
+// Split
+//*************************************************************************************
+
+void TextSegmenter::Split(std::string const& s_String, std::vector<std::string>& v_Segment) const
+{
+    v_Segment.clear();
+    
+    if (b_Enabled == false)
+    {
+        AddSegment(s_String, 0, s_String.size(), v_Segment);
+        return;
+    }
+    
+    size_t us_Size = s_String.size();
+    size_t us_Start = 0;
+    size_t us_Clause = 0; // Last clause end, 0 if none
+    size_t us_Space = 0; // Last word end, 0 if none
+    size_t us_Pos = 0;
+    size_t us_Length;
+    Boundary e_Boundary;
+    bool b_Spaced;
+    
+    while (us_Pos < us_Size)
+    {
+        us_Length = GetCodePointLength(static_cast<unsigned char>(s_String[us_Pos]));
+        
+        if (us_Length > us_Size - us_Pos)
+        {
+            us_Length = us_Size - us_Pos;
+        }
+        
+        e_Boundary = GetBoundary(&(s_String[us_Pos]), us_Length, b_Spaced);
+        
+        if (GetSpace(s_String[us_Pos]) == true)
+        {
+            us_Space = us_Pos;
+        }
+        
+        us_Pos += us_Length;
+        
+        if (e_Boundary != NONE)
+        {
+            // Keep closing quotes and brackets with the boundary
+            while (us_Pos < us_Size && GetClosing(s_String[us_Pos]) == true)
+            {
+                ++us_Pos;
+            }
+            
+            // @NOTE: Spaced punctuation inside words is no boundary, 
+            //        for example numbers or abbreviations like "e.g."
+            if (b_Spaced == true && us_Pos < us_Size && GetSpace(s_String[us_Pos]) == false)
+            {
+                e_Boundary = NONE;
+            }
+        }
+        
+        if (e_Boundary == SENTENCE && (us_Pos - us_Start) >= us_MinLength)
+        {
+            AddSegment(s_String, us_Start, us_Pos, v_Segment);
+            
+            us_Start = us_Pos;
+            us_Clause = 0;
+            us_Space = 0;
+            continue;
+        }
+        else if (e_Boundary != NONE)
+        {
+            us_Clause = us_Pos;
+        }
+        
+        // Too long, split at the last clause or word
+        if (us_MaxLength > 0 && (us_Pos - us_Start) >= us_MaxLength)
+        {
+            size_t us_End = us_Pos;
+            
+            if (us_Clause > us_Start)
+            {
+                us_End = us_Clause;
+            }
+            else if (us_Space > us_Start)
+            {
+                us_End = us_Space;
+            }
+            
+            AddSegment(s_String, us_Start, us_End, v_Segment);
+            
+            us_Start = us_End;
+            us_Clause = 0;
+            us_Space = 0;
+        }
+    }
+    
+    AddSegment(s_String, us_Start, us_Size, v_Segment);
+}
+
+void TextSegmenter::AddSegment(std::string const& s_String, size_t us_Start, size_t us_End, std::vector<std::string>& v_Segment) const
+{
+    while (us_Start < us_End && GetSpace(s_String[us_Start]) == true)
+    {
+        ++us_Start;
+    }
+    
+    while (us_End > us_Start && GetSpace(s_String[us_End - 1]) == true)
+    {
+        --us_End;
+    }
+    
+    if (us_Start < us_End)
+    {
+        v_Segment.emplace_back(s_String, us_Start, us_End - us_Start);
+    }
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+TextSegmenter::Boundary TextSegmenter::GetBoundary(const char* p_CodePoint, size_t us_Length, bool& b_Spaced) const noexcept
+{
+    for (auto& Punctuation : p_Punctuation)
+    {
+        if (std::strlen(Punctuation.p_CodePoint) == us_Length && std::memcmp(Punctuation.p_CodePoint, p_CodePoint, us_Length) == 0)
+        {
+            b_Spaced = Punctuation.b_Spaced;
+            return Punctuation.b_Sentence == true ? SENTENCE : CLAUSE;
+        }
+    }
+    
+    b_Spaced = false;
+    return NONE;
+}
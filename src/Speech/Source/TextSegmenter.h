@@ -0,0 +1,126 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef TextSegmenter_h
+#define TextSegmenter_h
+
+// C / C++
+#include <string>
+#include <vector>
+
+// External
+#include <MRH_Typedefs.h>
+
+// Project
+
+
+class TextSegmenter
+{
+public:
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     *
+     *  \param b_Enabled If strings are split into segments.
+     *  \param u32_MinLength The minimum length in bytes of a sentence segment.
+     *  \param u32_MaxLength The length in bytes after which a segment is split at 
+     *                       clauses or words, 0 for no limit.
+     */
+    
+    TextSegmenter(bool b_Enabled, MRH_Uint32 u32_MinLength, MRH_Uint32 u32_MaxLength) noexcept;
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~TextSegmenter() noexcept;
+    
+    //*************************************************************************************
+    // Split
+    //*************************************************************************************
+    
+    /**
+     *  Split a UTF-8 string at sentence and clause boundaries. Segments never 
+     *  split a code point. This function is thread safe.
+     *
+     *  \param s_String The UTF-8 string to split.
+     *  \param v_Segment The string segments in order. The segments are replaced 
+     *                   and empty if the string was only whitespace.
+     */
+    
+    void Split(std::string const& s_String, std::vector<std::string>& v_Segment) const;
+    
+private:
+    
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+    
+    enum Boundary
+    {
+        NONE = 0,
+        CLAUSE = 1,
+        SENTENCE = 2
+    };
+    
+    //*************************************************************************************
+    // Split
+    //*************************************************************************************
+    
+    /**
+     *  Add a trimmed segment.
+     *
+     *  \param s_String The split string.
+     *  \param us_Start The segment start in bytes.
+     *  \param us_End The segment end in bytes.
+     *  \param v_Segment The segments to add to.
+     */
+    
+    void AddSegment(std::string const& s_String, size_t us_Start, size_t us_End, std::vector<std::string>& v_Segment) const;
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the boundary type of a code point.
+     *
+     *  \param p_CodePoint The UTF-8 code point.
+     *  \param us_Length The code point length in bytes.
+     *  \param b_Spaced Set to true if the boundary has to be followed by whitespace.
+     *
+     *  \return The boundary type.
+     */
+    
+    Boundary GetBoundary(const char* p_CodePoint, size_t us_Length, bool& b_Spaced) const noexcept;
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    bool b_Enabled;
+    size_t us_MinLength;
+    size_t us_MaxLength;
+    
+protected:
+    
+};
+
+#endif /* TextSegmenter_h */
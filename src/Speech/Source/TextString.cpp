@@ -30,9 +30,13 @@
 // Constructor / Destructor
 //*************************************************************************************
 
-TextString::TextString(Configuration const& c_Configuration) : LocalStream(c_Configuration.GetTextStringSocketPath()),
-                                                               u64_RecieveTimestampS(0),
-                                                               u32_RecieveTimeoutS(c_Configuration.GetTextStringRecieveTimeoutS())
+TextString::TextString(Configuration const& c_Configuration, LocalStreamReactor& c_Reactor) : LocalStream(c_Reactor,
+                                                                                                           c_Configuration.GetTextStringSocketPath(),
+                                                                                                           c_Configuration.GetServiceStreamRingCapacity()),
+                                                                                               u64_RecieveTimestampS(0),
+                                                                                               u32_RecieveTimeoutS(c_Configuration.GetTextStringRecieveTimeoutS()),
+                                                                                               u32_PendingStringID(0),
+                                                                                               u32_PendingGroupID(0)
 {
     MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::INFO, "Using text string communication.",
                                    "TextString.cpp", __LINE__);
@@ -48,19 +52,19 @@ TextString::~TextString() noexcept
 MRH_Uint32 TextString::Receive(MRH_Uint32 u32_StringID) noexcept
 {
     MRH_LS_M_String_Data c_Message;
-    std::vector<MRH_Uint8> v_Message(MRH_STREAM_MESSAGE_BUFFER_SIZE, 0);
+    MessagePool::Buffer c_Buffer;
     MRH_Uint32 u32_NextStringID = u32_StringID;
     
     // Read all messages recieved
-    while (LocalStream::Receive(v_Message) == true)
+    while (LocalStream::Receive(c_Buffer) == true)
     {
-        if (MRH_LS_GetBufferMessage(v_Message.data()) != MRH_LS_M_STRING)
+        if (MRH_LS_GetBufferMessage(c_Buffer.GetData()) != MRH_LS_M_STRING)
         {
             MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::WARNING, "Unknown local stream message recieved!",
                                            "TextString.cpp", __LINE__);
             continue;
         }
-        else if (MRH_LS_BufferToMessage(&c_Message, v_Message.data(), v_Message.size()) < 0)
+        else if (MRH_LS_BufferToMessage(&c_Message, c_Buffer.GetData(), c_Buffer.GetSize()) < 0)
         {
             MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::ERROR, MRH_ERR_GetLocalStreamErrorString(),
                                            "TextString.cpp", __LINE__);
@@ -95,6 +99,12 @@ MRH_Uint32 TextString::Receive(MRH_Uint32 u32_StringID) noexcept
 
 void TextString::Send(OutputStorage& c_OutputStorage) noexcept
 {
+    // Retry the string which did not fit the send buffer first
+    if (c_Pending.GetValid() == true && SendPending() == false)
+    {
+        return;
+    }
+    
     if (c_OutputStorage.GetAvailable() == false)
     {
         return;
@@ -114,29 +124,60 @@ void TextString::Send(OutputStorage& c_OutputStorage) noexcept
             auto String = c_OutputStorage.GetString();
             
             MRH_LS_M_String_Data c_Message;
-            std::vector<MRH_Uint8> v_Message(MRH_STREAM_MESSAGE_BUFFER_SIZE, 0);
+            MessagePool::Buffer c_Buffer = MessagePool::Singleton().Acquire();
             MRH_Uint32 u32_Size;
             
             strncpy(c_Message.p_String, String.s_String.c_str(), MRH_STREAM_MESSAGE_BUFFER_SIZE);
             
-            if (MRH_LS_MessageToBuffer(&(v_Message[0]), &u32_Size, MRH_LS_M_STRING, &c_Message) < 0)
+            if (MRH_LS_MessageToBuffer(c_Buffer.GetData(), &u32_Size, MRH_LS_M_STRING, &c_Message) < 0)
             {
                 throw Exception(MRH_ERR_GetLocalStreamErrorString());
             }
             
-            v_Message.resize(u32_Size);
+            c_Buffer.SetSize(u32_Size);
             
-            // Send and set performed
-            LocalStream::Send(v_Message);
-            SpeechEvent::OutputPerformed(String.u32_StringID,
-                                         String.u32_GroupID);
+            c_Pending = std::move(c_Buffer);
+            u32_PendingStringID = String.u32_StringID;
+            u32_PendingGroupID = String.u32_GroupID;
         }
         catch (Exception& e)
         {
             MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::ERROR, e.what(),
                                            "TextString.cpp", __LINE__);
+            continue;
+        }
+        
+        // Full, continue on the next update
+        if (SendPending() == false)
+        {
+            return;
+        }
+    }
+}
+
+bool TextString::SendPending() noexcept
+{
+    try
+    {
+        if (LocalStream::Send(c_Pending) == false)
+        {
+            return false;
         }
+        
+        // Sent, set performed
+        SpeechEvent::OutputPerformed(u32_PendingStringID,
+                                     u32_PendingGroupID);
     }
+    catch (Exception& e)
+    {
+        MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::ERROR, e.what(),
+                                       "TextString.cpp", __LINE__);
+        
+        // @NOTE: Invalid messages are never retried
+        c_Pending = MessagePool::Buffer();
+    }
+    
+    return true;
 }
 
 //*************************************************************************************
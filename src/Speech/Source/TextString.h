@@ -41,9 +41,10 @@ public:
      *  Default constructor.
      *
      *  \param c_Configuration The configuration to construct with.
+     *  \param c_Reactor The reactor servicing the text string local stream.
      */
     
-    TextString(Configuration const& c_Configuration);
+    TextString(Configuration const& c_Configuration, LocalStreamReactor& c_Reactor);
     
     /**
      *  Default destructor.
@@ -106,6 +107,18 @@ private:
     
     static bool GetCommunicationActive(MRH_Uint64 u64_TimestampS, MRH_Uint32 u32_TimeoutS) noexcept;
     
+    //*************************************************************************************
+    // Send
+    //*************************************************************************************
+    
+    /**
+     *  Send the pending string message and set it performed.
+     *
+     *  \return true if the message was handled, false if the send buffer is full.
+     */
+    
+    bool SendPending() noexcept;
+    
     //*************************************************************************************
     // Data
     //*************************************************************************************
@@ -114,6 +127,11 @@ private:
     std::atomic<MRH_Uint64> u64_RecieveTimestampS;
     MRH_Uint32 u32_RecieveTimeoutS;
     
+    // Send
+    MessagePool::Buffer c_Pending; // Did not fit the send buffer
+    MRH_Uint32 u32_PendingStringID;
+    MRH_Uint32 u32_PendingGroupID;
+    
 protected:
 
 };
@@ -16,6 +16,7 @@
 
 // C / C++
 #include <cstring>
+#include <chrono>
 
 // External
 #include <libmrhpsb/MRH_PSBLogger.h>
@@ -23,29 +24,92 @@
 
 // Project
 #include "./Voice.h"
-#if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
-#include "./APIProvider/GoogleCloudAPI.h"
-#endif
 #include "../SpeechEvent.h"
+#include "../../Metrics.h"
+
+// Pre-defined
+#ifndef MRH_SPEECH_AUDIO_CAPTURE_SHARE
+    #define MRH_SPEECH_AUDIO_CAPTURE_SHARE 4 // 1 / n of the audio memory reserved for recording
+#endif
+
+namespace
+{
+    inline MRH_Uint32 GetPlaybackLeadMS(Configuration const& c_Configuration) noexcept
+    {
+        // @NOTE: Playback is paced on each update, the lead has to cover 
+        //        the longest wait between updates
+        MRH_Uint32 u32_MinLeadMS = c_Configuration.GetServiceMethodWaitMS() * 2;
+        
+        return c_Configuration.GetVoicePlaybackLeadMS() > u32_MinLeadMS ? c_Configuration.GetVoicePlaybackLeadMS() : u32_MinLeadMS;
+    }
+}
 
 
 //*************************************************************************************
 // Constructor / Destructor
 //*************************************************************************************
 
-Voice::Voice(Configuration const& c_Configuration) : LocalStream(c_Configuration.GetVoiceSocketPath()),
-                                                     c_Input(c_Configuration.GetVoiceRecordingKHz()),
-                                                     u32_RecordingTimeoutS(c_Configuration.GetVoiceRecordingTimeoutS()),
-                                                     u64_LastAudioTimePointS(time(NULL)),
-                                                     b_InitialRecording(false),
-                                                     c_Output(c_Configuration.GetVoicePlaybackKHz()),
-                                                     b_OutputSet(false),
-                                                     e_APIProvider(static_cast<APIProvider>(c_Configuration.GetVoiceAPIProvider())),
+Voice::Voice(Configuration const& c_Configuration, LocalStreamReactor& c_Reactor, Signal& c_Signal) : LocalStream(c_Reactor,
+                                                                                                                   c_Configuration.GetVoiceSocketPath(),
+                                                                                                                   c_Configuration.GetServiceStreamRingCapacity()),
+#if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
+                                                                                                       c_GoogleCloudAPI(c_Configuration),
+#endif
+                                                                                                       u32_RecognitionKHz(c_Configuration.GetVoiceRecognitionKHz()),
+                                                                                                       c_Input(c_Configuration.GetVoiceRecognitionKHz(), AudioPool::CAPTURE),
+                                                                                                       u32_RecordingTimeoutS(c_Configuration.GetVoiceRecordingTimeoutS()),
+                                                                                                       u64_LastAudioTimePointS(time(NULL)),
+                                                                                                       b_InitialRecording(false),
+                                                                                                       c_Recognizer(c_Configuration,
 #if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
-                                                     s_GoogleLangCode(c_Configuration.GetGoogleLanguageCode()),
-                                                     u8_GoogleVoiceGender(c_Configuration.GetGoogleVoiceGender())
+                                                                                                                    c_GoogleCloudAPI,
 #endif
+                                                                                                                    c_Signal),
+                                                                                                       b_ActivityDetection(c_Configuration.GetVoiceActivityDetection()),
+                                                                                                       c_Activity(c_Configuration.GetVoiceRecognitionKHz(),
+                                                                                                                  c_Configuration.GetVoiceActivityThreshold(),
+                                                                                                                  c_Configuration.GetVoiceActivityOnsetMS(),
+                                                                                                                  c_Configuration.GetVoiceActivityHangoverMS(),
+                                                                                                                  c_Configuration.GetVoiceActivityPreRollMS()),
+                                                                                                       b_StreamRecognition(c_Configuration.GetVoiceStreamRecognition()),
+                                                                                                       p_Stream(NULL),
+                                                                                                       c_StreamRecognizer(c_Configuration,
+#if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
+                                                                                                                          c_GoogleCloudAPI,
+#endif
+                                                                                                                          c_Signal),
+                                                                                                       u32_PlaybackKHz(c_Configuration.GetVoicePlaybackKHz()),
+                                                                                                       c_Synthesizer(c_Configuration,
+#if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
+                                                                                                                     c_GoogleCloudAPI,
+#endif
+                                                                                                                     c_Signal),
+                                                                                                       c_Output(c_Configuration.GetVoiceSynthesisKHz(), 0, 0, true),
+                                                                                                       u32_SynthesizeAhead(c_Configuration.GetVoiceSynthesizeAhead() > 0 ? c_Configuration.GetVoiceSynthesizeAhead() : 1),
+                                                                                                       u32_PlaybackStrings(0),
+                                                                                                       us_PlaybackSegment(0),
+                                                                                                       us_PlaybackOffset(0),
+                                                                                                       c_Scheduler(c_Configuration.GetVoicePlaybackKHz(),
+                                                                                                                   GetPlaybackLeadMS(c_Configuration)),
+                                                                                                       b_OutputSent(false),
+                                                                                                       b_PlaybackSent(false),
+                                                                                                       b_PlaybackFlushed(false),
+                                                                                                       u32_FlushTimeoutMS(GetPlaybackLeadMS(c_Configuration) + c_Configuration.GetServiceMethodWaitMS()),
+                                                                                                       b_OutputWarned(false),
+                                                                                                       b_BargeIn(c_Configuration.GetVoiceBargeIn()),
+                                                                                                       b_EchoCancellation(c_Configuration.GetVoiceEchoCancellation()),
+                                                                                                       c_Echo(c_Configuration.GetVoiceRecognitionKHz(),
+                                                                                                              c_Configuration.GetVoiceEchoFilterMS(),
+                                                                                                              c_Configuration.GetVoiceEchoDelayMS())
 {
+    // @NOTE: Bounds all recorded and synthesized audio, queued playback 
+    //        never takes the memory needed for recording
+    size_t us_AudioMemory = static_cast<size_t>(c_Configuration.GetVoiceAudioMemoryKB()) * 1024;
+    size_t us_CaptureMemory = us_AudioMemory / MRH_SPEECH_AUDIO_CAPTURE_SHARE;
+    
+    AudioPool::Singleton().SetLimit(AudioPool::CAPTURE, us_CaptureMemory);
+    AudioPool::Singleton().SetLimit(AudioPool::PLAYBACK, us_AudioMemory - us_CaptureMemory);
+    
     MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::INFO, "Using audio stream communication. API providers are: "
 #if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
                                                         "[ Google Cloud API ]"
@@ -63,18 +127,30 @@ Voice::~Voice() noexcept
 
 void Voice::StartRecording() noexcept
 {
-    MRH_Uint32 u32_Message = MRH_LS_M_AUDIO_START_RECORDING;
-    std::vector<MRH_Uint8> v_Message(&u32_Message, &u32_Message + sizeof(MRH_Uint32));
-    
-    LocalStream::Send(v_Message);
+    SendOpcode(MRH_LS_M_AUDIO_START_RECORDING);
 }
 
 void Voice::StopRecording() noexcept
 {
-    MRH_Uint32 u32_Message = MRH_LS_M_AUDIO_STOP_RECORDING;
-    std::vector<MRH_Uint8> v_Message(&u32_Message, &u32_Message + sizeof(MRH_Uint32));
-    
-    LocalStream::Send(v_Message);
+    SendOpcode(MRH_LS_M_AUDIO_STOP_RECORDING);
+}
+
+void Voice::SendOpcode(MRH_Uint32 u32_Opcode) noexcept
+{
+    try
+    {
+        MessagePool::Buffer c_Message = MessagePool::Singleton().Acquire();
+        
+        std::memcpy(c_Message.GetData(), &u32_Opcode, sizeof(MRH_Uint32));
+        c_Message.SetSize(sizeof(MRH_Uint32));
+        
+        SendMessage(c_Message);
+    }
+    catch (Exception& e)
+    {
+        MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::ERROR, e.what(),
+                                       "Voice.cpp", __LINE__);
+    }
 }
 
 //*************************************************************************************
@@ -83,14 +159,16 @@ void Voice::StopRecording() noexcept
 
 MRH_Uint32 Voice::Retrieve(MRH_Uint32 u32_StringID, bool b_DiscardInput)
 {
-    // No client or data, do nothing
+    // No client or data, only add finished input
     if (LocalStream::IsConnected() == false)
     {
-        // Reset sent waiting
-        if (b_OutputSet == true)
-        {
-            b_OutputSet = false;
-        }
+        // Reset sent waiting and discard unsent messages
+        dq_Performing.clear();
+        dq_Pending.clear();
+        ClearPlayback();
+        
+        b_PlaybackSent = false;
+        b_PlaybackFlushed = false;
         
         // Reset recording start on connection request
         if (b_InitialRecording == false)
@@ -98,7 +176,7 @@ MRH_Uint32 Voice::Retrieve(MRH_Uint32 u32_StringID, bool b_DiscardInput)
             b_InitialRecording = true;
         }
         
-        return u32_StringID;
+        return AddInput(u32_StringID);
     }
     
     // Request recording start
@@ -113,112 +191,343 @@ MRH_Uint32 Voice::Retrieve(MRH_Uint32 u32_StringID, bool b_DiscardInput)
     MRH_PSBLogger& c_Logger = MRH_PSBLogger::Singleton();
     
     // Recieve data
-    std::vector<MRH_Uint8> v_Message;
+    MessagePool::Buffer c_Buffer;
     MRH_LS_M_Audio_Data c_Message;
     
-    try
+    while (LocalStream::Receive(c_Buffer) == true)
     {
-        while (LocalStream::Receive(v_Message) == true)
+        // Is this a usable opcode?
+        switch (MRH_LS_GetBufferMessage(c_Buffer.GetData()))
         {
-            // Is this a usable opcode?
-            switch (MRH_LS_GetBufferMessage(v_Message.data()))
+            /**
+             *  Input
+             */
+            
+            case MRH_LS_M_AUDIO:
             {
-                /**
-                 *  Input
-                 */
-                
-                case MRH_LS_M_AUDIO:
+                if (MRH_LS_BufferToMessage(&c_Message, c_Buffer.GetData(), c_Buffer.GetSize()) < 0)
                 {
-                    if (MRH_LS_BufferToMessage(&c_Message, v_Message.data(), v_Message.size()) < 0)
-                    {
-                        c_Logger.Log(MRH_PSBLogger::ERROR, MRH_ERR_GetLocalStreamErrorString(),
-                                     "Voice.cpp", __LINE__);
-                    }
-                    else
-                    {
-                        // @NOTE: Messages are sent / recieved in sequence
-                        //        Adding them in a loop adds them correctly
-                        c_Input.AddAudio(c_Message.p_Samples,
-                                         c_Message.u32_Samples);
-                        
-                        // Increase timer for timeout to transcribe
-                        u64_LastAudioTimePointS = time(NULL);
-                    }
+                    c_Logger.Log(MRH_PSBLogger::ERROR, MRH_ERR_GetLocalStreamErrorString(),
+                                 "Voice.cpp", __LINE__);
                     break;
                 }
-                    
-                /**
-                 *  Output
-                 */
-                    
-                case MRH_LS_M_AUDIO_PLAYBACK_FINISHED:
+                
+                try
                 {
-                    if (b_OutputSet == true)
-                    {
-                        // Reset even if performed event fails
-                        b_OutputSet = false;
-                        
-                        SpeechEvent::OutputPerformed(u32_OutputID,
-                                                     u32_OutputGroup);
-                    }
+                    AddAudio(c_Message, b_DiscardInput);
+                }
+                catch (Exception& e)
+                {
+                    c_Logger.Log(MRH_PSBLogger::ERROR, e.what(),
+                                 "Voice.cpp", __LINE__);
+                }
+                
+                // Increase timer for timeout to transcribe
+                u64_LastAudioTimePointS = time(NULL);
+                break;
+            }
+                
+            /**
+             *  Output
+             */
+                
+            case MRH_LS_M_AUDIO_PLAYBACK_FINISHED:
+            {
+                b_PlaybackSent = false;
+                
+                // @NOTE: Answers the flush, the flushed strings were 
+                //        already reported
+                if (b_PlaybackFlushed == true)
+                {
+                    b_PlaybackFlushed = false;
                     break;
                 }
+                
+                // @NOTE: Strings are sent back to back, playback finishes 
+                //        once all sent strings were played
+                c_Scheduler.Reset();
+                
+                while (dq_Performing.size() > 0)
+                {
+                    OutputStorage::String const& c_Performed = dq_Performing.front();
                     
-                /**
-                 *  Default
-                 */
+                    try
+                    {
+                        SpeechEvent::OutputPerformed(c_Performed.u32_StringID,
+                                                     c_Performed.u32_GroupID);
+                    }
+                    catch (Exception& e)
+                    {
+                        c_Logger.Log(MRH_PSBLogger::ERROR, e.what(),
+                                     "Voice.cpp", __LINE__);
+                    }
                     
-                default: 
-                { 
-                    MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::WARNING, "Unknown local stream message recieved!",
-                                                   "Voice.cpp", __LINE__);
-                    break; 
+                    // Remove even if performed event fails
+                    dq_Performing.pop_front();
                 }
+                break;
+            }
+                
+            /**
+             *  Default
+             */
+                
+            default: 
+            { 
+                c_Logger.Log(MRH_PSBLogger::WARNING, "Unknown local stream message recieved!",
+                             "Voice.cpp", __LINE__);
+                break; 
             }
         }
     }
-    catch (Exception& e)
+    
+    // End the stream on timeout, the provider might finish earlier
+    if (p_Stream != NULL && (b_DiscardInput == true || (u64_LastAudioTimePointS + u32_RecordingTimeoutS) <= static_cast<MRH_Uint64>(time(NULL))))
     {
-        throw;
+        p_Stream->End();
+        p_Stream = NULL;
+        
+        c_Activity.Reset();
     }
     
     // Can we work with the data we have
-    if (c_Input.GetSampleCount() == 0 || u64_LastAudioTimePointS < (time(NULL) + u32_RecordingTimeoutS))
+    if (c_Input.GetSampleCount() > 0 && (u64_LastAudioTimePointS + u32_RecordingTimeoutS) <= static_cast<MRH_Uint64>(time(NULL)))
+    {
+        // @NOTE: The source stopped sending audio, the utterance is complete
+        c_Activity.Reset();
+        
+        HandOff(b_DiscardInput);
+    }
+    
+    return AddInput(u32_StringID);
+}
+
+void Voice::AddAudio(MRH_LS_M_Audio_Data const& c_Message, bool b_DiscardInput)
+{
+    // @NOTE: Sources record at their native rate, the provider recieves 
+    //        the recognition rate
+    const MRH_Sint16* p_Samples = c_Message.p_Samples;
+    size_t us_Samples = c_Message.u32_Samples;
+    
+    Resample(p_CaptureResampler, c_Message.u32_KHz, u32_RecognitionKHz, p_Samples, us_Samples);
+    
+    // Remove our own playback before detection and recognition
+    if (b_EchoCancellation == true)
+    {
+        CancelEcho(p_Samples, us_Samples);
+    }
+    
+    // Audio after the timeout starts the next utterance
+    bool b_Timeout = (u64_LastAudioTimePointS + u32_RecordingTimeoutS) <= static_cast<MRH_Uint64>(time(NULL));
+    
+    if (b_ActivityDetection == true)
+    {
+        // @NOTE: Utterances are transcribed once the end of speech 
+        //        was detected
+        DetectActivity(p_Samples, us_Samples, b_DiscardInput);
+    }
+    else if (b_StreamRecognition == true)
+    {
+        if (p_Stream != NULL && b_Timeout == true)
+        {
+            p_Stream->End();
+            p_Stream = NULL;
+        }
+        
+        // @NOTE: Discarded audio is never streamed
+        if (b_DiscardInput == false)
+        {
+            StreamAudio(p_Samples, us_Samples);
+        }
+    }
+    else
     {
-        return u32_StringID;
+        if (c_Input.GetSampleCount() > 0 && b_Timeout == true)
+        {
+            HandOff(b_DiscardInput);
+        }
+        
+        // @NOTE: Messages are sent / recieved in sequence
+        //        Adding them in a loop adds them correctly
+        c_Input.AddAudio(p_Samples, us_Samples);
     }
+}
+
+void Voice::CancelEcho(const MRH_Sint16*& p_Samples, size_t us_Samples)
+{
+    try
+    {
+        v_Cancelled.assign(p_Samples, p_Samples + us_Samples);
+    }
+    catch (std::exception& e)
+    {
+        throw Exception("Failed to cancel echo: " + std::string(e.what()));
+    }
+    
+    std::chrono::steady_clock::time_point c_Start = std::chrono::steady_clock::now();
+    
+    c_Echo.Process(v_Cancelled.data(), v_Cancelled.size());
+    
+    MRH_Uint64 u64_TimeUS = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - c_Start).count();
+    Metrics& c_Metrics = Metrics::Singleton();
+    
+    c_Metrics.Add(Metrics::ECHO_CANCEL_FRAME);
+    c_Metrics.Add(Metrics::ECHO_CANCEL_TIME_US, u64_TimeUS);
+    c_Metrics.SetMax(Metrics::ECHO_CANCEL_TIME_MAX_US, u64_TimeUS);
+    
+    p_Samples = v_Cancelled.data();
+}
+
+void Voice::HandOff(bool b_DiscardInput)
+{
+    // @NOTE: Capture continues in a fresh buffer before the recognizer is 
+    //        involved, a utterance is never mixed into the next one
+    AudioBuffer c_Utterance(std::move(c_Input));
+    c_Input.Clear(c_Utterance.GetKHz());
     
     // Got data, should we transcribe?
-    if (b_DiscardInput == false)
+    // @NOTE: Transcription happens asynchronously in recording order
+    if (b_DiscardInput == false && c_Utterance.GetSampleCount() > 0)
     {
-        std::string s_Input;
+        c_Recognizer.Add(std::move(c_Utterance));
+    }
+}
+
+void Voice::StreamAudio(const MRH_Sint16* p_Buffer, size_t us_Elements)
+{
+    // Start a new utterance stream once the last one was finished
+    if (p_Stream == NULL || p_Stream->GetClosed() == true)
+    {
+        p_Stream = std::make_shared<AudioStream>(u32_RecognitionKHz);
         
         try
         {
-            switch (e_APIProvider)
+            c_StreamRecognizer.Add(std::shared_ptr<AudioStream>(p_Stream));
+        }
+        catch (Exception& e)
+        {
+            p_Stream = NULL;
+            throw;
+        }
+    }
+    
+    p_Stream->Write(p_Buffer,
+                    us_Elements);
+}
+
+void Voice::DetectActivity(const MRH_Sint16* p_Samples, size_t us_Samples, bool b_DiscardInput)
+{
+    size_t us_Processed;
+    bool b_Speech;
+    bool b_End;
+    
+    while (us_Samples > 0)
+    {
+        b_Speech = c_Activity.GetSpeech();
+        us_Processed = c_Activity.Process(p_Samples, us_Samples, c_Input, b_End);
+        
+        p_Samples += us_Processed;
+        us_Samples -= us_Processed;
+        
+        // Speech started during playback, the user interrupts output
+        // @NOTE: The detected utterance continues as new input
+        if (b_BargeIn == true && b_DiscardInput == false && b_Speech == false && c_Activity.GetSpeech() == true && GetPlaybackActive() == true)
+        {
+            BargeIn();
+        }
+        
+        // Streamed utterances are sent while detected
+        if (b_StreamRecognition == true && c_Input.GetSampleCount() > 0)
+        {
+            if (b_DiscardInput == false)
             {
-#if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
-                case GOOGLE_CLOUD_API:
-                    s_Input = GoogleCloudAPI::Transcribe(c_Input,
-                                                         s_GoogleLangCode);
-                    break;
-#endif
-                default:
-                    throw Exception("Unknown API provider!");
+                const MRH_Sint16* p_Segment;
+                size_t us_Elements;
+                
+                for (size_t i = 0; i < c_Input.GetSegmentCount(); ++i)
+                {
+                    p_Segment = c_Input.GetSegment(i, us_Elements);
+                    StreamAudio(p_Segment, us_Elements);
+                }
             }
             
-            // Transcribed, add input
-            SpeechEvent::InputRecieved(u32_StringID, s_Input);
-            ++u32_StringID;
+            c_Input.Clear(c_Input.GetKHz());
         }
-        catch (Exception& e)
+        
+        if (b_End == true)
         {
-            throw;
+            EndUtterance(b_DiscardInput);
         }
     }
-          
-    // Clean up and return
-    c_Input.Clear(c_Input.GetKHz());
+}
+
+void Voice::EndUtterance(bool b_DiscardInput)
+{
+    if (b_DiscardInput == true)
+    {
+        c_Input.Clear(c_Input.GetKHz());
+        return;
+    }
+    
+    if (b_StreamRecognition == true)
+    {
+        if (p_Stream != NULL)
+        {
+            p_Stream->End();
+            p_Stream = NULL;
+        }
+    }
+    else
+    {
+        HandOff(false);
+    }
+    
+    // Time between the last speech and the start of the transcription
+    MRH_Uint64 u64_LatencyMS = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - c_Activity.GetSpeechEnd()).count();
+    Metrics& c_Metrics = Metrics::Singleton();
+    
+    c_Metrics.Add(Metrics::VOICE_ENDPOINT);
+    c_Metrics.Add(Metrics::VOICE_ENDPOINT_LATENCY_MS, u64_LatencyMS);
+    c_Metrics.SetMax(Metrics::VOICE_ENDPOINT_LATENCY_MAX_MS, u64_LatencyMS);
+}
+
+void Voice::Resample(std::unique_ptr<Resampler>& p_Resampler, MRH_Uint32 u32_InputKHz, MRH_Uint32 u32_OutputKHz, const MRH_Sint16*& p_Buffer, size_t& us_Elements)
+{
+    if (u32_InputKHz == u32_OutputKHz)
+    {
+        return;
+    }
+    
+    // Rates only change with the connected source
+    if (p_Resampler == NULL || p_Resampler->GetInputKHz() != u32_InputKHz || p_Resampler->GetOutputKHz() != u32_OutputKHz)
+    {
+        p_Resampler.reset(new Resampler(u32_InputKHz, u32_OutputKHz));
+    }
+    
+    p_Resampler->Process(p_Buffer, us_Elements, v_Resampled);
+    
+    p_Buffer = v_Resampled.data();
+    us_Elements = v_Resampled.size();
+}
+
+MRH_Uint32 Voice::AddInput(MRH_Uint32 u32_StringID)
+{
+    // @NOTE: Results are returned in recording order, string ids are
+    //        only assigned on the speech thread
+    std::string s_Input;
+    
+    while (c_Recognizer.GetResult(s_Input) == true)
+    {
+        SpeechEvent::InputRecieved(u32_StringID, s_Input);
+        ++u32_StringID;
+    }
+    
+    while (c_StreamRecognizer.GetResult(s_Input) == true)
+    {
+        SpeechEvent::InputRecieved(u32_StringID, s_Input);
+        ++u32_StringID;
+    }
+    
     return u32_StringID;
 }
 
@@ -228,103 +537,437 @@ MRH_Uint32 Voice::Retrieve(MRH_Uint32 u32_StringID, bool b_DiscardInput)
 
 void Voice::Send(OutputStorage& c_OutputStorage)
 {
-    if (c_OutputStorage.GetAvailable() == false)
+    if (LocalStream::IsConnected() == false)
     {
+        // @NOTE: Output is kept until connected, warn only once
+        if (b_OutputWarned == false && c_OutputStorage.GetAvailable() == true)
+        {
+            b_OutputWarned = true;
+            throw Exception("Audio local stream is not connected!");
+        }
+        
         return;
     }
-    else if (LocalStream::IsConnected() == false)
-    {
-        throw Exception("Audio local stream is not connected!");
-    }
     
-    // Check if output is currently being sent
-    if (b_OutputSet == true)
+    b_OutputWarned = false;
+    
+    // Messages which did not fit the send buffer on the last update
+    SendPending();
+    
+    // Synthesize ahead while output is performed
+    // @NOTE: Strings waiting for playback count as synthesized ahead, 
+    //        which bounds the audio kept for playback
+    while ((dq_Synthesizing.size() + u32_PlaybackStrings) < u32_SynthesizeAhead && c_OutputStorage.GetAvailable() == true)
     {
-        MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::WARNING, "Can't send output, waiting for result for output" +
-                                                               std::to_string(u32_OutputID),
-                                       "Voice.cpp", __LINE__);
-        return;
+        OutputStorage::String c_String(c_OutputStorage.GetString());
+        
+        c_Synthesizer.AddString(c_String);
+        dq_Synthesizing.emplace_back(std::move(c_String));
     }
     
-    // Nothing sent, send next output
-    try
+    // Queue segments in order as soon as they are synthesized
+    while (c_Synthesizer.GetResult(c_Output) == true)
     {
-        auto String = c_OutputStorage.GetString();
+        // Strings in front lost their last segment
+        while (dq_Synthesizing.size() > 0 && dq_Synthesizing.front().u32_StringID != c_Output.u32_StringID)
+        {
+            EndOutput();
+        }
         
-        switch (e_APIProvider)
+        if (c_Output.b_LastSegment == true)
         {
-#if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
-            case GOOGLE_CLOUD_API:
-                GoogleCloudAPI::Synthesise(c_Output,
-                                           String.s_String,
-                                           s_GoogleLangCode,
-                                           u8_GoogleVoiceGender);
-                break;
-#endif
-            default:
-                throw Exception("Unknown API provider!");
+            dq_Synthesizing.pop_front();
+            ++u32_PlaybackStrings;
         }
         
-        // Create output messages
-        MRH_LS_M_Audio_Data c_Message;
-        std::vector<MRH_Uint8> v_Message(MRH_STREAM_MESSAGE_TOTAL_SIZE, 0);
-        MRH_Uint32 u32_Size;
+        dq_Playback.emplace_back(std::move(c_Output));
+    }
+    
+    // @NOTE: Results lost without a last segment leave nothing pending
+    if (dq_Synthesizing.size() > 0 && c_Synthesizer.GetPending() == 0)
+    {
+        while (dq_Synthesizing.size() > 0)
+        {
+            EndOutput();
+        }
+    }
+    
+    // Send queued audio back to back, paced to playback
+    SendPlayback();
+}
+
+void Voice::EndOutput()
+{
+    // Playback performs the string end in order
+    dq_Playback.emplace_back(u32_PlaybackKHz,
+                             dq_Synthesizing.front().u32_StringID,
+                             dq_Synthesizing.front().u32_GroupID,
+                             true);
+    
+    dq_Synthesizing.pop_front();
+    ++u32_PlaybackStrings;
+}
+
+void Voice::SendPlayback()
+{
+    // @NOTE: New audio waits for the flush answer, which would 
+    //        otherwise finish the new playback
+    if (b_PlaybackFlushed == true)
+    {
+        if (std::chrono::steady_clock::now() < c_FlushDeadline)
+        {
+            return;
+        }
         
-        // Set KHz for all
-        c_Message.u32_KHz = c_Output.GetKHz();
+        // Clients without flush support never answer
+        b_PlaybackFlushed = false;
         
-        // @TODO: This is a lot of copying at the moment,
-        //        find a better solution!
-        //        Simply assigning (if possible for message struct) doesn't
-        //        work since there is no guarantee when the message will be 
-        //        sent!
-        size_t us_TotalSize = c_Output.GetSampleCount() * sizeof(MRH_Sint16);
-        MRH_Uint32 u32_SamplesPerMessage = MRH_STREAM_MESSAGE_AUDIO_BUFFER_SIZE;
-        MRH_Uint32 u32_CopySize;
+        MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::WARNING, "Playback stop was not answered, continuing output.",
+                                       "Voice.cpp", __LINE__);
+    }
+    
+    // Create output messages
+    MRH_LS_M_Audio_Data c_Message;
+    
+    // Set KHz for all
+    c_Message.u32_KHz = u32_PlaybackKHz;
+    c_Message.u32_Samples = 0;
+    
+    // @NOTE: One synthesis serves any playback rate, audio is converted 
+    //        while the messages are filled
+    size_t us_Sendable = c_Scheduler.GetSendable();
+    const MRH_Sint16* p_Segment;
+    size_t us_Elements;
+    MRH_Uint32 u32_OutputKHz;
+    
+    while (dq_Playback.size() > 0)
+    {
+        SynthesizerOutput& c_Playback = dq_Playback.front();
         
-        const MRH_Uint8* p_Current = (const MRH_Uint8*)(c_Output.GetBuffer());
-        const MRH_Uint8* p_End = p_Current + us_TotalSize;
+        // Stored phrases are read directly from the mapped store
+        if (c_Playback.c_Phrase.p_Samples != NULL)
+        {
+            p_Segment = us_PlaybackSegment == 0 ? c_Playback.c_Phrase.p_Samples : NULL;
+            us_Elements = us_PlaybackSegment == 0 ? c_Playback.c_Phrase.us_Samples : 0;
+            u32_OutputKHz = c_Playback.c_Phrase.u32_KHz;
+        }
+        else if (us_PlaybackSegment < c_Playback.c_Audio.GetSegmentCount())
+        {
+            p_Segment = c_Playback.c_Audio.GetSegment(us_PlaybackSegment, us_Elements);
+            u32_OutputKHz = c_Playback.c_Audio.GetKHz();
+        }
+        else
+        {
+            p_Segment = NULL;
+            us_Elements = 0;
+            u32_OutputKHz = c_Playback.c_Audio.GetKHz();
+        }
         
-        while (p_Current != p_End)
+        if (p_Segment != NULL && us_PlaybackOffset < us_Elements)
         {
-            // Perform copy to buffer
-            if ((p_End - p_Current) > us_TotalSize)
+            // Wait for playback or the send buffer to continue
+            if (us_Sendable == 0 || dq_Pending.size() > 0)
             {
-                u32_CopySize = us_TotalSize - (p_End - p_Current);
+                break;
             }
-            else
+            
+            // @NOTE: Audio is sent in frames, sending stops within one 
+            //        frame once cancelled
+            size_t us_Frame = u32_OutputKHz / 100;
+            
+            if (us_Frame == 0 || us_Frame > us_Elements - us_PlaybackOffset)
             {
-                u32_CopySize = u32_SamplesPerMessage;
+                us_Frame = us_Elements - us_PlaybackOffset;
             }
             
-            c_Message.u32_Samples = (u32_CopySize / 2);
-            std::memcpy(c_Message.p_Samples, p_Current, u32_CopySize);
+            p_Segment += us_PlaybackOffset;
+            us_PlaybackOffset += us_Frame;
             
-            p_Current += u32_CopySize;
+            Resample(p_PlaybackResampler, u32_OutputKHz, u32_PlaybackKHz, p_Segment, us_Frame);
+            AddPlayback(c_Message, p_Segment, us_Frame);
             
-            // Send message with copied audio
-            if (MRH_LS_MessageToBuffer(&(v_Message[0]), &u32_Size, MRH_LS_M_AUDIO, &c_Message) < 0)
+            us_Sendable = us_Sendable > us_Frame ? us_Sendable - us_Frame : 0;
+            b_OutputSent = true;
+            continue;
+        }
+        else if (p_Segment != NULL)
+        {
+            // Next audio buffer segment
+            ++us_PlaybackSegment;
+            us_PlaybackOffset = 0;
+            continue;
+        }
+        
+        // Remaining resampled audio
+        if (b_OutputSent == true && u32_OutputKHz != u32_PlaybackKHz && p_PlaybackResampler != NULL)
+        {
+            p_PlaybackResampler->Flush(v_Resampled);
+            AddPlayback(c_Message, v_Resampled.data(), v_Resampled.size());
+        }
+        
+        // Segment sent, strings with sent audio wait for playback
+        if (c_Playback.b_LastSegment == true)
+        {
+            if (b_OutputSent == true)
             {
-                // @NOTE: No crashing, hope for next message to work
-                continue;
+                dq_Performing.emplace_back(std::string(),
+                                           c_Playback.u32_StringID,
+                                           c_Playback.u32_GroupID);
             }
             
-            LocalStream::Send(v_Message);
+            b_OutputSent = false;
+            --u32_PlaybackStrings;
+        }
+        
+        dq_Playback.pop_front();
+        us_PlaybackSegment = 0;
+        us_PlaybackOffset = 0;
+    }
+    
+    if (c_Message.u32_Samples > 0)
+    {
+        SendAudio(c_Message);
+    }
+}
+
+void Voice::BargeIn() noexcept
+{
+    // Stop output first, nothing is sent after this point
+    c_Synthesizer.Clear();
+    
+    // @NOTE: The client answers the flush if audio was still playing, 
+    //        otherwise the finish for the sent audio answers it
+    if (b_PlaybackSent == true)
+    {
+        SendOpcode(MRH_LS_M_AUDIO_PLAYBACK_FINISHED);
+        
+        b_PlaybackSent = false;
+        b_PlaybackFlushed = true;
+        c_FlushDeadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(u32_FlushTimeoutMS);
+    }
+    
+    // @NOTE: Cancelled strings are reported as performed in output order, 
+    //        sent strings first
+    std::deque<OutputStorage::String> dq_Cancelled(std::move(dq_Performing));
+    dq_Performing.clear();
+    
+    for (auto& Playback : dq_Playback)
+    {
+        if (Playback.b_LastSegment == true)
+        {
+            dq_Cancelled.emplace_back(std::string(), 
+                                      Playback.u32_StringID, 
+                                      Playback.u32_GroupID);
+        }
+    }
+    
+    for (auto& Synthesizing : dq_Synthesizing)
+    {
+        dq_Cancelled.emplace_back(std::move(Synthesizing));
+    }
+    
+    dq_Synthesizing.clear();
+    ClearPlayback();
+    
+    MRH_PSBLogger& c_Logger = MRH_PSBLogger::Singleton();
+    Metrics& c_Metrics = Metrics::Singleton();
+    
+    c_Metrics.Add(Metrics::VOICE_BARGE_IN);
+    c_Metrics.Add(Metrics::VOICE_BARGE_IN_CANCELLED, dq_Cancelled.size());
+    
+    for (auto& Cancelled : dq_Cancelled)
+    {
+        try
+        {
+            SpeechEvent::OutputPerformed(Cancelled.u32_StringID,
+                                         Cancelled.u32_GroupID);
+            
+            c_Logger.Log(MRH_PSBLogger::INFO, "Output string " + 
+                                              std::to_string(Cancelled.u32_StringID) + 
+                                              " cancelled by barge-in.",
+                         "Voice.cpp", __LINE__);
+        }
+        catch (std::exception& e)
+        {
+            c_Logger.Log(MRH_PSBLogger::ERROR, e.what(),
+                         "Voice.cpp", __LINE__);
+        }
+    }
+}
+
+void Voice::ClearPlayback() noexcept
+{
+    // Discard audio which did not fit the send buffer
+    for (auto It = dq_Pending.begin(); It != dq_Pending.end();)
+    {
+        if (MRH_LS_GetBufferMessage(It->GetData()) == MRH_LS_M_AUDIO)
+        {
+            It = dq_Pending.erase(It);
+        }
+        else
+        {
+            ++It;
+        }
+    }
+    
+    dq_Playback.clear();
+    u32_PlaybackStrings = 0;
+    us_PlaybackSegment = 0;
+    us_PlaybackOffset = 0;
+    b_OutputSent = false;
+    
+    if (p_PlaybackResampler != NULL)
+    {
+        p_PlaybackResampler->Reset();
+    }
+    
+    if (p_ReferenceResampler != NULL)
+    {
+        p_ReferenceResampler->Reset();
+    }
+    
+    c_Scheduler.Reset();
+    c_Echo.ClearReference();
+}
+
+void Voice::AddPlayback(MRH_LS_M_Audio_Data& c_Message, const MRH_Sint16* p_Buffer, size_t us_Elements)
+{
+    // @NOTE: Audio is copied once into the message, which is built in a pool 
+    //        buffer handed to the local stream without further copies
+    const MRH_Uint32 u32_MessageSamples = MRH_STREAM_MESSAGE_AUDIO_BUFFER_SIZE / sizeof(MRH_Sint16);
+    MRH_Uint32 u32_CopySize;
+    
+    while (us_Elements > 0)
+    {
+        // Fill the message, messages span segments
+        u32_CopySize = u32_MessageSamples - c_Message.u32_Samples;
+        
+        if (us_Elements < u32_CopySize)
+        {
+            u32_CopySize = static_cast<MRH_Uint32>(us_Elements);
         }
         
-        // Sent, clear
-        c_Output.Clear(c_Output.GetKHz());
+        std::memcpy(&(c_Message.p_Samples[c_Message.u32_Samples]), p_Buffer, u32_CopySize * sizeof(MRH_Sint16));
         
-        // Remember output data
-        u32_OutputID = String.u32_StringID;
-        u32_OutputGroup = String.u32_GroupID;
+        p_Buffer += u32_CopySize;
+        us_Elements -= u32_CopySize;
+        c_Message.u32_Samples += u32_CopySize;
         
-        b_OutputSet = true;
+        // Send full messages, the remaining audio is sent last
+        if (c_Message.u32_Samples == u32_MessageSamples)
+        {
+            SendAudio(c_Message);
+            c_Message.u32_Samples = 0;
+        }
     }
-    catch (Exception& e)
+}
+
+void Voice::SendAudio(MRH_LS_M_Audio_Data& c_Message)
+{
+    MessagePool::Buffer c_Buffer = MessagePool::Singleton().Acquire();
+    MRH_Uint32 u32_Size;
+    
+    if (MRH_LS_MessageToBuffer(c_Buffer.GetData(), &u32_Size, MRH_LS_M_AUDIO, &c_Message) < 0)
+    {
+        // @NOTE: No crashing, hope for next message to work
+        return;
+    }
+    
+    c_Buffer.SetSize(u32_Size);
+    SendMessage(c_Buffer);
+    
+    c_Scheduler.Add(c_Message.u32_Samples);
+    
+    // Sent audio is the echo reference
+    if (b_EchoCancellation == true)
+    {
+        const MRH_Sint16* p_Reference = c_Message.p_Samples;
+        size_t us_Reference = c_Message.u32_Samples;
+        
+        try
+        {
+            // @NOTE: The playback buffer is still in use, the reference 
+            //        is resampled separately
+            if (c_Message.u32_KHz != u32_RecognitionKHz)
+            {
+                if (p_ReferenceResampler == NULL || p_ReferenceResampler->GetInputKHz() != c_Message.u32_KHz)
+                {
+                    p_ReferenceResampler.reset(new Resampler(c_Message.u32_KHz, u32_RecognitionKHz));
+                }
+                
+                p_ReferenceResampler->Process(p_Reference, us_Reference, v_Reference);
+                
+                p_Reference = v_Reference.data();
+                us_Reference = v_Reference.size();
+            }
+            
+            c_Echo.AddReference(p_Reference, us_Reference);
+        }
+        catch (Exception& e)
+        {
+            MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::ERROR, e.what(),
+                                           "Voice.cpp", __LINE__);
+        }
+    }
+}
+
+void Voice::SendMessage(MessagePool::Buffer& c_Message)
+{
+    // @NOTE: Messages keep their order, nothing is sent before pending ones
+    if (dq_Pending.size() == 0 && SendBuffer(c_Message) == true)
+    {
+        return;
+    }
+    
+    try
+    {
+        dq_Pending.emplace_back(std::move(c_Message));
+    }
+    catch (std::exception& e)
+    {
+        throw Exception("Failed to keep voice message: " + std::string(e.what()));
+    }
+}
+
+bool Voice::SendPending() noexcept
+{
+    while (dq_Pending.size() > 0)
     {
-        throw;
+        try
+        {
+            if (SendBuffer(dq_Pending.front()) == false)
+            {
+                return false;
+            }
+        }
+        catch (Exception& e)
+        {
+            MRH_PSBLogger::Singleton().Log(MRH_PSBLogger::ERROR, e.what(),
+                                           "Voice.cpp", __LINE__);
+        }
+        
+        dq_Pending.pop_front();
     }
+    
+    return true;
+}
+
+bool Voice::SendBuffer(MessagePool::Buffer& c_Message)
+{
+    bool b_Audio = (MRH_LS_GetBufferMessage(c_Message.GetData()) == MRH_LS_M_AUDIO);
+    
+    if (LocalStream::Send(c_Message) == false)
+    {
+        return false;
+    }
+    
+    // Audio reached the client, a barge-in has to flush
+    if (b_Audio == true)
+    {
+        b_PlaybackSent = true;
+    }
+    
+    return true;
 }
 
 //*************************************************************************************
@@ -335,3 +978,8 @@ bool Voice::GetSourceConnected() noexcept
 {
     return LocalStream::IsConnected();
 }
+
+bool Voice::GetPlaybackActive() noexcept
+{
+    return b_OutputSent == true || dq_Performing.size() > 0 || c_Scheduler.GetBuffered() > 0;
+}
@@ -18,13 +18,22 @@
 #define Voice_h
 
 // C / C++
+#include <deque>
+#include <chrono>
 
 // External
 #include <libmrhpsb/MRH_Callback.h>
+#include <libmrhls.h>
 
 // Project
-#include "./APIProvider/APIProvider.h"
 #include "./Audio/AudioBuffer.h"
+#include "./Audio/EchoCanceller.h"
+#include "./Audio/PlaybackScheduler.h"
+#include "./Audio/Resampler.h"
+#include "./Audio/VoiceActivity.h"
+#include "./Recognizer.h"
+#include "./StreamRecognizer.h"
+#include "./Synthesizer.h"
 #include "../../Configuration.h"
 #include "../LocalStream.h"
 #include "../OutputStorage.h"
@@ -42,9 +51,11 @@ public:
      *  Default constructor.
      *
      *  \param c_Configuration The configuration to construct with.
+     *  \param c_Reactor The reactor servicing the voice local stream.
+     *  \param c_Signal The signal notified when recognition or synthesis finished.
      */
     
-    Voice(Configuration const& c_Configuration);
+    Voice(Configuration const& c_Configuration, LocalStreamReactor& c_Reactor, Signal& c_Signal);
     
     /**
      *  Default destructor.
@@ -73,10 +84,10 @@ public:
     //*************************************************************************************
     
     /**
-     *  Retrieve recieved data from the voice source.
+     *  Retrieve recieved data from the voice source and add transcribed input.
      *
      *  \param u32_StringID The string id to use for the first input.
-     *  \param b_DiscardInput If recieved input should be discarded.
+     *  \param b_DiscardInput If recieved audio should be discarded instead of transcribed.
      *
      *  \return The new string id after retrieving.
      */
@@ -88,7 +99,7 @@ public:
     //*************************************************************************************
     
     /**
-     *  Add output to send to the voice source.
+     *  Synthesize output and send synthesized output to the voice source.
      *
      *  \param c_OutputStorage The output storage to send from.
      */
@@ -109,28 +120,251 @@ public:
     
 private:
     
+    //*************************************************************************************
+    // Recording
+    //*************************************************************************************
+    
+    /**
+     *  Send a message without data to the voice source.
+     *
+     *  \param u32_Opcode The message opcode.
+     */
+    
+    void SendOpcode(MRH_Uint32 u32_Opcode) noexcept;
+    
+    //*************************************************************************************
+    // Retrieve
+    //*************************************************************************************
+    
+    /**
+     *  Add recieved audio to the current utterance.
+     *
+     *  \param c_Message The recieved audio message.
+     *  \param b_DiscardInput If recieved audio should be discarded.
+     */
+    
+    void AddAudio(MRH_LS_M_Audio_Data const& c_Message, bool b_DiscardInput);
+    
+    /**
+     *  Remove the playback echo from audio at the recognition KHz.
+     *
+     *  \param p_Samples The audio buffer, set to the processed audio.
+     *  \param us_Samples The elements in the audio buffer.
+     */
+    
+    void CancelEcho(const MRH_Sint16*& p_Samples, size_t us_Samples);
+    
+    /**
+     *  Stream audio at the recognition KHz to the active utterance stream.
+     *
+     *  \param p_Buffer The audio buffer.
+     *  \param us_Elements The elements in the audio buffer.
+     */
+    
+    void StreamAudio(const MRH_Sint16* p_Buffer, size_t us_Elements);
+    
+    /**
+     *  Detect utterances in audio at the recognition KHz.
+     *
+     *  \param p_Samples The audio buffer.
+     *  \param us_Samples The elements in the audio buffer.
+     *  \param b_DiscardInput If detected utterances should be discarded.
+     */
+    
+    void DetectActivity(const MRH_Sint16* p_Samples, size_t us_Samples, bool b_DiscardInput);
+    
+    /**
+     *  Transcribe the detected utterance.
+     *
+     *  \param b_DiscardInput If the utterance should be discarded.
+     */
+    
+    void EndUtterance(bool b_DiscardInput);
+    
+    /**
+     *  Hand the recorded utterance to the recognizer and continue recording 
+     *  into a empty buffer.
+     *
+     *  \param b_DiscardInput If the utterance should be discarded.
+     */
+    
+    void HandOff(bool b_DiscardInput);
+    
+    /**
+     *  Add all transcribed input in recording order.
+     *
+     *  \param u32_StringID The string id to use for the first input.
+     *
+     *  \return The new string id after adding.
+     */
+    
+    MRH_Uint32 AddInput(MRH_Uint32 u32_StringID);
+    
+    //*************************************************************************************
+    // Resample
+    //*************************************************************************************
+    
+    /**
+     *  Resample audio if the KHz differ. Resampled audio is valid until the 
+     *  next resample.
+     *
+     *  \param p_Resampler The resampler to use, replaced on KHz changes.
+     *  \param u32_InputKHz The KHz of the audio.
+     *  \param u32_OutputKHz The required KHz.
+     *  \param p_Buffer The audio buffer, set to the resampled audio.
+     *  \param us_Elements The elements in the audio buffer, set to the resampled elements.
+     */
+    
+    void Resample(std::unique_ptr<Resampler>& p_Resampler, MRH_Uint32 u32_InputKHz, MRH_Uint32 u32_OutputKHz, const MRH_Sint16*& p_Buffer, size_t& us_Elements);
+    
+    //*************************************************************************************
+    // Send
+    //*************************************************************************************
+    
+    /**
+     *  End the oldest synthesizing string without its last segment.
+     */
+    
+    void EndOutput();
+    
+    /**
+     *  Send queued playback audio to the voice source, paced to playback.
+     */
+    
+    void SendPlayback();
+    
+    /**
+     *  Discard all queued playback audio.
+     */
+    
+    void ClearPlayback() noexcept;
+    
+    /**
+     *  Cancel all output taken for playback and request the voice source 
+     *  to stop playback. Cancelled strings are reported as performed.
+     */
+    
+    void BargeIn() noexcept;
+    
+    /**
+     *  Add playback audio to a audio message. Full messages are sent.
+     *
+     *  \param c_Message The audio message to fill.
+     *  \param p_Buffer The audio buffer.
+     *  \param us_Elements The elements in the audio buffer.
+     */
+    
+    void AddPlayback(MRH_LS_M_Audio_Data& c_Message, const MRH_Sint16* p_Buffer, size_t us_Elements);
+    
+    /**
+     *  Send a audio message to the voice source.
+     *
+     *  \param c_Message The audio message to send.
+     */
+    
+    void SendAudio(MRH_LS_M_Audio_Data& c_Message);
+    
+    /**
+     *  Send a message to the voice source. Messages which do not fit the 
+     *  send buffer are kept and sent in order.
+     *
+     *  \param c_Message The message to send. The message is consumed.
+     */
+    
+    void SendMessage(MessagePool::Buffer& c_Message);
+    
+    /**
+     *  Send kept messages.
+     *
+     *  \return true if all messages were sent, false if not.
+     */
+    
+    bool SendPending() noexcept;
+    
+    /**
+     *  Add a message to the local stream send buffer.
+     *
+     *  \param c_Message The message to send. The message is consumed if added.
+     *
+     *  \return true if added, false if the send buffer is full.
+     */
+    
+    bool SendBuffer(MessagePool::Buffer& c_Message);
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Check if sent output is currently played by the voice source.
+     *
+     *  \return true if playing, false if not.
+     */
+    
+    bool GetPlaybackActive() noexcept;
+    
     //*************************************************************************************
     // Data
     //*************************************************************************************
     
+    // API Provider
+    // @NOTE: Used by the recognizer and synthesizer, keep before them
+#if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
+    GoogleCloudAPI::Client c_GoogleCloudAPI;
+#endif
+    
+    // Resample
+    std::unique_ptr<Resampler> p_CaptureResampler;
+    std::unique_ptr<Resampler> p_PlaybackResampler;
+    std::vector<MRH_Sint16> v_Resampled;
+    
     // Input
+    MRH_Uint32 u32_RecognitionKHz;
     AudioBuffer c_Input;
     MRH_Uint32 u32_RecordingTimeoutS;
     MRH_Uint64 u64_LastAudioTimePointS;
     bool b_InitialRecording;
+    Recognizer c_Recognizer;
+    
+    // Voice Activity
+    bool b_ActivityDetection;
+    VoiceActivity c_Activity;
+    
+    // Streamed Input
+    bool b_StreamRecognition;
+    std::shared_ptr<AudioStream> p_Stream;
+    StreamRecognizer c_StreamRecognizer;
     
     // Output
-    AudioBuffer c_Output;
-    bool b_OutputSet;
-    MRH_Uint32 u32_OutputID;
-    MRH_Uint32 u32_OutputGroup;
+    MRH_Uint32 u32_PlaybackKHz;
+    Synthesizer c_Synthesizer;
+    SynthesizerOutput c_Output;
+    MRH_Uint32 u32_SynthesizeAhead;
+    std::deque<OutputStorage::String> dq_Synthesizing;
     
-    // Google Cloud API
-    APIProvider e_APIProvider;
-#if MRH_API_PROVIDER_GOOGLE_CLOUD_API > 0
-    std::string s_GoogleLangCode;
-    MRH_Uint8 u8_GoogleVoiceGender;
-#endif
+    // Playback
+    std::deque<SynthesizerOutput> dq_Playback;
+    MRH_Uint32 u32_PlaybackStrings; // Last segments in playback
+    size_t us_PlaybackSegment;
+    size_t us_PlaybackOffset;
+    PlaybackScheduler c_Scheduler;
+    std::deque<OutputStorage::String> dq_Performing; // Sent, playback not finished
+    std::deque<MessagePool::Buffer> dq_Pending; // Did not fit the send buffer
+    bool b_OutputSent; // Audio of the front playback string was sent
+    bool b_PlaybackSent; // Audio sent since the last playback finished
+    bool b_PlaybackFlushed; // Waiting for the flush answer
+    MRH_Uint32 u32_FlushTimeoutMS;
+    std::chrono::steady_clock::time_point c_FlushDeadline;
+    bool b_OutputWarned;
+    bool b_BargeIn;
+    
+    // Echo Cancellation
+    // @NOTE: Sent playback is the reference for recorded audio
+    bool b_EchoCancellation;
+    EchoCanceller c_Echo;
+    std::unique_ptr<Resampler> p_ReferenceResampler;
+    std::vector<MRH_Sint16> v_Reference;
+    std::vector<MRH_Sint16> v_Cancelled;
     
 protected:
 
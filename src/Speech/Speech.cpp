@@ -21,6 +21,7 @@
 
 // Project
 #include "./Speech.h"
+#include "../Metrics.h"
 
 
 //*************************************************************************************
@@ -28,11 +29,13 @@
 //*************************************************************************************
 
 Speech::Speech(Configuration const& c_Configuration) : b_Update(true),
+                                                       c_OutputStorage(c_Signal),
+                                                       c_Reactor(c_Signal),
 #if MRH_SPEECH_USE_VOICE > 0
-                                                       c_Voice(c_Configuration),
+                                                       c_Voice(c_Configuration, c_Reactor, c_Signal),
 #endif
 #if MRH_SPEECH_USE_TEXT_STRING > 0
-                                                       c_TextString(c_Configuration),
+                                                       c_TextString(c_Configuration, c_Reactor),
 #endif
                                                        e_Method(AUDIO)
 {
@@ -44,7 +47,8 @@ Speech::Speech(Configuration const& c_Configuration) : b_Update(true),
     {
         c_Thread = std::thread(Update, 
                                this, 
-                               c_Configuration.GetServiceMethodWaitMS());
+                               c_Configuration.GetServiceMethodWaitMS(),
+                               c_Configuration.GetServiceMetricsIntervalS());
     }
     catch (std::exception& e)
     {
@@ -55,6 +59,7 @@ Speech::Speech(Configuration const& c_Configuration) : b_Update(true),
 Speech::~Speech() noexcept
 {
     b_Update = false;
+    c_Signal.Notify();
     c_Thread.join();
 }
 
@@ -62,7 +67,7 @@ Speech::~Speech() noexcept
 // Update
 //*************************************************************************************
 
-void Speech::Update(Speech* p_Instance, MRH_Uint32 u32_MethodWaitMS) noexcept
+void Speech::Update(Speech* p_Instance, MRH_Uint32 u32_MethodWaitMS, MRH_Uint32 u32_MetricsIntervalS) noexcept
 {
     // Set used objects
     MRH_PSBLogger& c_Logger = MRH_PSBLogger::Singleton();
@@ -79,12 +84,30 @@ void Speech::Update(Speech* p_Instance, MRH_Uint32 u32_MethodWaitMS) noexcept
     // Shared default string id
     MRH_Uint32 u32_StringID = 0;
     
+    // Metrics logging
+    MRH_Uint64 u64_MetricsTimePointS = time(NULL) + u32_MetricsIntervalS;
+    
     while (p_Instance->b_Update == true)
     {
-        // Wait a bit for data
-        // @NOTE: We ALWAYS wait - we want servers, string clients and audio devices to have sent
-        //        some data before recieving
-        std::this_thread::sleep_for(std::chrono::milliseconds(u32_MethodWaitMS));
+        // Wait for input, output or a connection change
+        // @NOTE: The wait time is only a limit, timeouts are checked on every
+        //        update
+        p_Instance->c_Signal.Wait(u32_MethodWaitMS);
+        
+        if (p_Instance->b_Update == false)
+        {
+            break;
+        }
+        
+        /**
+         *  Metrics
+         */
+        
+        if (u32_MetricsIntervalS > 0 && u64_MetricsTimePointS <= static_cast<MRH_Uint64>(time(NULL)))
+        {
+            Metrics::Singleton().Log();
+            u64_MetricsTimePointS = time(NULL) + u32_MetricsIntervalS;
+        }
         
         /**
          *  Text String
@@ -132,13 +155,15 @@ void Speech::Update(Speech* p_Instance, MRH_Uint32 u32_MethodWaitMS) noexcept
             // Text string in use, retrieve and discard input
             if (p_Instance->e_Method == TEXT_STRING)
             {
-                // Discard input but recieve finished output before returning
-                c_Voice.Retrieve(0, true);
+                // Discard input but recieve finished output and input before returning
+                u32_StringID = c_Voice.Retrieve(u32_StringID, true);
                 continue;
             }
             
             // Voice in use, get input and performed output
             // before sending output
+            // @NOTE: Recognition and synthesis run asynchronously,
+            //        both only hand over finished results here
             u32_StringID = c_Voice.Retrieve(u32_StringID, false);
             c_Voice.Send(c_OutputStorage);
         }
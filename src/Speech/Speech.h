@@ -34,6 +34,8 @@
 #include "./OutputStorage.h"
 #include "../Configuration.h"
 #endif
+#include "./LocalStreamReactor.h"
+#include "./Signal.h"
 
 
 class Speech
@@ -110,10 +112,11 @@ private:
      *  Update speech methods.
      *
      *  \param p_Instance The speech instance to update.
-     *  \param u32_MethodWaitMS The wait time b etween each method update.
+     *  \param u32_MethodWaitMS The maximum wait time between each method update.
+     *  \param u32_MetricsIntervalS The interval in which metrics are logged, 0 if disabled.
      */
     
-    static void Update(Speech* p_Instance, MRH_Uint32 u32_MethodWaitMS) noexcept;
+    static void Update(Speech* p_Instance, MRH_Uint32 u32_MethodWaitMS, MRH_Uint32 u32_MetricsIntervalS) noexcept;
     
     //*************************************************************************************
     // Data
@@ -123,8 +126,15 @@ private:
     std::atomic<bool> b_Update;
     std::atomic<Method> e_Method;
     
+    // @NOTE: Notified by all speech sources, keep before them
+    Signal c_Signal;
+    
     OutputStorage c_OutputStorage;
     
+    // @NOTE: All local streams are serviced by the same reactor thread,
+    //        keep before the sources for destruction order
+    LocalStreamReactor c_Reactor;
+    
 #if MRH_SPEECH_USE_VOICE > 0
     Voice c_Voice;
 #endif